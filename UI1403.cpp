@@ -22,6 +22,7 @@
 
 #include <dir.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "ubcd.h"
 #include "UI1410CPUT.h"
@@ -47,6 +48,7 @@ __fastcall TFI1403::TFI1403(TComponent* Owner)
     PrintPosition = 0;
     PrintData = false;
     Line = 1;
+    PaperNext = PaperNew = PaperShown = 0;
 
    	// WindowState = wsMinimized;
 }
@@ -77,10 +79,9 @@ bool TFI1403::NextLine() {
         sprintf(PrintBuffer,"<%d>",Line);
     }
 
-    if(Paper -> Lines -> Capacity > PRINTMAXLINES) {
-        Paper -> Lines -> Delete(0);
-    }
-	Paper -> Lines -> Add(PrintBuffer);
+    strcpy(PaperRing[PaperNext],PrintBuffer);
+    PaperNext = (PaperNext + 1) % PRINTMAXLINES;
+    ++PaperNew;
     ++Line;
     PrintPosition = 0;
     PrintBuffer[0] = '\0';
@@ -187,3 +188,12 @@ void __fastcall TFI1403::CarriageTapeClick(TObject *Sender)
 }
 //---------------------------------------------------------------------------
 
+//  Bring the paper up to date from the ring, if anything has been printed
+//  since the last time (see RingToMemo).
+
+void __fastcall TFI1403::PaperTimerTimer(TObject *Sender)
+{
+    RingToMemo(Paper,&PaperRing[0][0],PRINTPOSITIONS + 1,PRINTMAXLINES,
+        PaperNext,PaperNew,PaperShown,PaperLength);
+}
+//---------------------------------------------------------------------------
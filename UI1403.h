@@ -30,6 +30,13 @@
 #define PRINTPOSITIONS  132
 #define PRINTMAXLINES   100
 
+//  The paper in the window is a ring of the last PRINTMAXLINES lines.
+//  Printing a line just puts it in the ring.  The window itself is
+//  brought up to date from the ring by PaperTimer, only if something
+//  changed, so the screen keeps up at a steady rate no matter how fast
+//  the printer goes.  Only the new lines are added to the window, and
+//  the ones they push out of the ring are cut off the top.
+
 class TFI1403 : public TForm
 {
 __published:	// IDE-managed Components
@@ -52,6 +59,7 @@ __published:	// IDE-managed Components
     TButton *EnablePrinter;
     TOpenDialog *FileCaptureDialog;
     TButton *CarriageTape;
+    TTimer *PaperTimer;
     void __fastcall StartClick(TObject *Sender);
     void __fastcall CheckResetClick(TObject *Sender);
     void __fastcall StopClick(TObject *Sender);
@@ -62,6 +70,7 @@ __published:	// IDE-managed Components
 
     void __fastcall EnableFileClick(TObject *Sender);
     void __fastcall CarriageTapeClick(TObject *Sender);
+    void __fastcall PaperTimerTimer(TObject *Sender);
 private:	// User declarations
 
     int PrintPosition;
@@ -69,6 +78,12 @@ private:	// User declarations
     char PrintBuffer[PRINTPOSITIONS + 1];
     int Line;
 
+    char PaperRing[PRINTMAXLINES][PRINTPOSITIONS + 1];
+    int PaperNext;                              //  Next line in the ring
+    int PaperNew;                               //  Not in the window yet
+    int PaperShown;                             //  Lines in the window
+    int PaperLength[PRINTMAXLINES];             //  Each, in window, w/ CRLF
+
 public:		// User declarations
     __fastcall TFI1403(TComponent* Owner);
     bool SendBCD(BCD c);
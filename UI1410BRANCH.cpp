@@ -56,7 +56,7 @@ void T1410CPU::InstructionBranchCond()
         break;
 
     case OP_MOD_SYMBOL_K:
-        for(ch = 0; ch < MAXCHANNEL; ++ch) {
+        for(ch = 0; ch < Channels; ++ch) {
             if(Channel[ch] -> IsTapeIndicate()) {
                 BranchLatch = true;
             }
@@ -99,12 +99,13 @@ void T1410CPU::InstructionBranchCond()
         break;
 
     case OP_MOD_SYMBOL_1:
-        BranchLatch = Channel[CHANNEL1] -> ChOverlap -> State();
-        break;
-
     case OP_MOD_SYMBOL_2:
-        if(MAXCHANNEL > 1) {
-            BranchLatch = Channel[CHANNEL2] -> ChOverlap -> State();
+    case OP_MOD_SYMBOL_3:
+    case OP_MOD_SYMBOL_4:
+        ch = op_mod - OP_MOD_SYMBOL_1;
+        if(ch < Channels) {
+            BranchLatch = Channel[ch] -> ChOverlap -> State();
+            TIdleDetector::Poll(I_AR -> Gate(),BranchLatch);
         }
         break;
 
@@ -139,38 +140,45 @@ void T1410CPU::InstructionBranchCond()
     return;
 }
 
+//  R tests channel 1 and X tests channel 2.  (Channels 3 and 4, if there
+//  are any, are tested with B and Y, d character 3 or 4).
+
 void T1410CPU::InstructionBranchChannel1() {
     InstructionBranchChannel(CHANNEL1);
 };
 
 void T1410CPU::InstructionBranchChannel2() {
-    if(MAXCHANNEL < 2) {
-        LastInstructionReadout = false;
-        IRingControl = true;
-        return;
-    }
     InstructionBranchChannel(CHANNEL2);
 }
 
 void T1410CPU::InstructionBranchChannel(int ch) {
 
     int op_mod;
+    __int64 waittime;
 
     op_mod = Op_Mod_Reg -> Get().ToInt() & 0x3f;
     assert(!BranchLatch);
-    assert(ch < MAXCHANNEL);                        //  ch is origin 0!
+    assert(ch < Channels);                          //  ch is origin 0!
 
     //  If channel was in overlap state, wait here until overlap is done.
+    //  The CPU is not doing anything else, so just move the clock ahead
+    //  to the channel's next event.  If it has none, it is waiting on the
+    //  outside world (e.g., the console operator).
 
     while(Channel[ch] -> ChOverlap -> State()) {
-        Channel[ch] -> DoOverlap();
-        TBusyDevice::BusyPass();                    //  Might be waiting (WTM)
+        if(Channel[ch] -> OverlapEvent -> IsPending()) {
+            waittime = TVirtualClock::Now();
+            TVirtualClock::AdvanceTo(Channel[ch] -> OverlapEvent -> GetDueTime());
+            Channel[ch] -> StallCycles += TVirtualClock::Now() - waittime;
+            TOverlapEvent::Service();
+        }
         Application -> ProcessMessages();
     }
 
     //  See if we have a match -- if so, we will branch.
 
     BranchLatch = (op_mod & Channel[ch] -> GetStatus());
+    TIdleDetector::Poll(I_AR -> Gate(),BranchLatch);
 
     //  If we branch, or if all bits tested, turn off Interlock,
     //  reset channel read/write status, and turn off the priority
@@ -304,9 +312,36 @@ void T1410CPU::InstructionBranchZoneWMEqual() {
     return;
 }
 
+//  The Y d characters that test a channel's priority requests: which
+//  channel, which request, and whether the test resets it.  Channels 3
+//  and 4 just have overlap priority.
+
+static struct {
+    int opmod;
+    int ch;
+    int request;
+    bool reset;
+} PriorityTests[] = {
+    { OP_MOD_SYMBOL_1, CHANNEL1, PROVERLAP, false },    //  R bbbbb d resets
+    { OP_MOD_SYMBOL_2, CHANNEL2, PROVERLAP, false },    //  X bbbbb d resets
+    { OP_MOD_SYMBOL_3, CHANNEL3, PROVERLAP, false },
+    { OP_MOD_SYMBOL_4, CHANNEL4, PROVERLAP, false },
+    { OP_MOD_SYMBOL_U, CHANNEL1, PRIOUNIT, true },
+    { OP_MOD_SYMBOL_F, CHANNEL2, PRIOUNIT, true },
+    { OP_MOD_SYMBOL_Q, CHANNEL1, PRINQUIRY, false },
+    { OP_MOD_SYMBOL_ASTERISK, CHANNEL2, PRINQUIRY, false },
+    { OP_MOD_SYMBOL_N, CHANNEL1, PROUTQUIRY, true },
+    { OP_MOD_SYMBOL_RM, CHANNEL2, PROUTQUIRY, true },
+    { OP_MOD_SYMBOL_S, CHANNEL1, PRSEEK, false },
+    { OP_MOD_SYMBOL_T, CHANNEL2, PRSEEK, false },
+    { OP_MOD_SYMBOL_A, CHANNEL1, PRATTENTION, true },
+    { OP_MOD_SYMBOL_B, CHANNEL2, PRATTENTION, true },
+    { -1, 0, 0, false }
+};
+
 void T1410CPU::InstructionPriorityBranch() {
 
-    int op_mod;
+    int op_mod, i, ch;
 
     op_mod = Op_Mod_Reg -> Get().ToInt() & 0x3f;
     assert(!BranchLatch);
@@ -323,70 +358,21 @@ void T1410CPU::InstructionPriorityBranch() {
         PriorityAlert -> Reset();
         break;
 
-    case OP_MOD_SYMBOL_1:
-        BranchLatch = (Channel[CHANNEL1] -> PriorityRequest & PROVERLAP) != 0;
-        //  Does not reset (R bbbbb d will reset)
-        break;
-
-    case OP_MOD_SYMBOL_2:
-        BranchLatch = (MAXCHANNEL > 1) &&
-            (Channel[CHANNEL2] -> PriorityRequest & PROVERLAP) != 0;
-        //  Does not reset (X bbbbb d will reset)
-        break;
-
-    case OP_MOD_SYMBOL_U:
-        BranchLatch = (Channel[CHANNEL1] -> PriorityRequest & PRIOUNIT) != 0;
-        Channel[CHANNEL1] -> PriorityRequest &= (~PRIOUNIT);
-        break;
-
-    case OP_MOD_SYMBOL_F:
-        BranchLatch = (MAXCHANNEL > 1) &&
-            (Channel[CHANNEL2] -> PriorityRequest & PRIOUNIT) != 0;
-        Channel[CHANNEL2] -> PriorityRequest &= (~PRIOUNIT);
-        break;
-
-    case OP_MOD_SYMBOL_Q:
-        BranchLatch = (Channel[CHANNEL1] -> PriorityRequest & PRINQUIRY) != 0;
-        break;
-
-    case OP_MOD_SYMBOL_ASTERISK:
-        BranchLatch = (MAXCHANNEL > 1) &&
-            (Channel[CHANNEL2] -> PriorityRequest & PRINQUIRY) != 0;
-        break;
-
-    case OP_MOD_SYMBOL_N:
-        BranchLatch = (Channel[CHANNEL1] -> PriorityRequest & PROUTQUIRY) != 0;
-        Channel[CHANNEL1] -> PriorityRequest &= (~PROUTQUIRY);
-        break;
-
-    case OP_MOD_SYMBOL_RM:
-        BranchLatch = (MAXCHANNEL > 1) &&
-            (Channel[CHANNEL2] -> PriorityRequest & PROUTQUIRY) != 0;
-        Channel[CHANNEL2] -> PriorityRequest &= (~PROUTQUIRY);
-        break;
-
-    case OP_MOD_SYMBOL_S:
-        BranchLatch = (Channel[CHANNEL1] -> PriorityRequest & PRSEEK) != 0;
-        break;
-
-    case OP_MOD_SYMBOL_T:
-        BranchLatch = (MAXCHANNEL > 1) &&
-            (Channel[CHANNEL2] -> PriorityRequest & PRSEEK) != 0;
-        break;
-
-    case OP_MOD_SYMBOL_A:
-        BranchLatch = (Channel[CHANNEL1] -> PriorityRequest & PRATTENTION) != 0;
-        Channel[CHANNEL1] -> PriorityRequest &= (~PRATTENTION);
-        break;
-
-    case OP_MOD_SYMBOL_B:
-        BranchLatch = (MAXCHANNEL > 1) &&
-            (Channel[CHANNEL2] -> PriorityRequest & PRATTENTION) != 0;
-        Channel[CHANNEL2] -> PriorityRequest &= (~PRATTENTION);
-        break;
-
     default:
-        ; //  Bad 'd' character - do nothing.
+        for(i=0; PriorityTests[i].opmod >= 0; ++i) {
+            if(PriorityTests[i].opmod == op_mod) {
+                break;
+            }
+        }
+        ch = PriorityTests[i].ch;
+        if(PriorityTests[i].opmod < 0 || ch >= Channels) {
+            break;                                  //  Bad 'd' character
+        }
+        BranchLatch =
+            (Channel[ch] -> PriorityRequest & PriorityTests[i].request) != 0;
+        if(PriorityTests[i].reset) {
+            Channel[ch] -> PriorityRequest &= (~PriorityTests[i].request);
+        }
     }
 
     if(BranchLatch) {                               //  Branching?
@@ -111,8 +111,12 @@ T1410Channel::T1410Channel(
     EndofRecord = false;
     TapeIndicate = false;
     UnitControlOverlapBusy = NULL;
+    OverlapEvent = new TOverlapEvent(this);
+    ResetTiming();
     PriorityRequest = 0;
     ChNOP = false;
+    Number = CHANNEL1;                      //  CPU sets the real one
+    CarriageUnit = 2;                       //  Printer is %20
 }
 
 //  Channel Register methods
@@ -153,6 +157,7 @@ void T1410Channel::OnComputerReset()
 {
     Reset();
     PriorityRequest = 0;
+    CarriageUnit = 2;                       //  Back to the panel printer
 }
 
 void T1410Channel::Reset() {
@@ -171,6 +176,7 @@ void T1410Channel::Reset() {
     ChOverlap -> Reset();
     ChNotOverlap -> Reset();
     UnitControlOverlapBusy = NULL;
+    OverlapEvent -> Cancel();
     ChNOP = false;
     //  Do *not* reset PriorityRequest!
 }
@@ -188,6 +194,12 @@ void T1410Channel::Display() {
 
 	int i;
 
+    //  Channels 3 and 4 have no lights.  (Their latches know that).
+
+    if(ChStatusDisplay[IOLAMPNOTREADY] == NULL) {
+        return;
+    }
+
 	ChStatusDisplay[IOLAMPNOTREADY] -> Enabled =
     	((ChStatus & IOCHNOTREADY) != 0);
 	ChStatusDisplay[IOLAMPBUSY] -> Enabled =
@@ -227,6 +239,10 @@ void T1410Channel::LampTest(bool b)
     //	the channel for lamp test.  They will take care of themselves on a
     //	lamp test.
 
+    if(ChStatusDisplay[IOLAMPNOTREADY] == NULL) {
+        return;
+    }
+
     if(!b) {
     	for(i=0; i <= 5; ++i) {
         	ChStatusDisplay[i] -> Enabled = true;
@@ -245,7 +261,7 @@ void T1410Channel::LampTest(bool b)
 
 T1410IODevice *T1410Channel::GetIODevice(int device) {
 
-    if(device < 0 || device > 64) {
+    if(device < 0 || device >= 64) {
         return(NULL);
     }
     return(Devices[device]);
@@ -259,7 +275,7 @@ void T1410Channel::DoOutput(TAddressRegister *addr) {
 
     BCD tempbcd;
 
-    CPU -> CycleRing -> Set(this == CPU -> Channel[CHANNEL1] ? CYCLE_E : CYCLE_F);
+    CPU -> CycleRing -> Set(DataCycle());
 
     //  Read out the next character.  Also, check for a storage wrap, which will
     //  end the transfer after this character.
@@ -345,14 +361,11 @@ void T1410Channel::DoInput(TAddressRegister *addr) {
     InputRequest = false;                           //  Reset co-routine flag
 
     if(!IntEndofTransfer) {                         //  Skip this if wrapped!
-        CPU -> CycleRing ->
-            Set(this == CPU -> Channel[CHANNEL1] ? CYCLE_E : CYCLE_F);
+        CPU -> CycleRing -> Set(DataCycle());
         *(CPU -> STAR) = *addr;                     //  Copy memory address
         CPU -> Readout();                           //  Get existing memory
         CPU -> StorageWrapCheck(+1);                //  Check for storage wrap
-        CPU -> AChannel -> Select(                  //  Gate A channel approp.
-            this == CPU -> Channel[CHANNEL1] ?
-                TAChannel::A_Channel_E : TAChannel::A_Channel_F );
+        CPU -> AChannel -> Select(DataSelect());    //  Gate A channel approp.
     }
 
     //  If no data from device, the end is near...
@@ -409,9 +422,7 @@ void T1410Channel::DoInput(TAddressRegister *addr) {
 
             if(FI1415CE -> AsteriskInsert -> Checked) {
                 ChR2 -> Set(BCD_ASTERISK);
-                CPU -> AChannel -> Select(
-                    this == CPU -> Channel[CHANNEL1] ?
-                        TAChannel::A_Channel_E : TAChannel::A_Channel_F);
+                CPU -> AChannel -> Select(DataSelect());
             }
         }   //  End initial parity check
 
@@ -485,9 +496,25 @@ bool T1410Channel::ChannelStrobe(BCD ch) {
     }
 
     InputRequest = true;                           //   Force co-routine call
+
+    //  If we are overlapped, the channel has to come back for this
+    //  character.  (The console strobes us from a key press, outside of
+    //  the CPU, so this is the only way it gets noticed).
+
+    if(ChOverlap -> State()) {
+        ScheduleOverlap();
+    }
     return true;
 }
 
+//  Reset the timing accumulated for the job report.  If we are in the
+//  middle of an overlapped operation, it counts from now.
+
+void T1410Channel::ResetTiming() {
+    OverlapStartTime = TVirtualClock::Now();
+    OverlapCycles = NotOverlapCycles = StallCycles = 0;
+}
+
 //  Channel Unit Control just passes it off to the device.
 
 void T1410Channel::DoUnitControl(BCD opmod) {
@@ -504,6 +531,7 @@ void T1410Channel::DoOverlap() {
 
     BCD SaveBReg,SaveAReg;
     long SaveSTAR;
+    long SaveStores;
     bool SaveStorageWrapLatch;
     char SaveCycle;
     enum TAChannel::TAChannelSelect AChannelSave;
@@ -521,6 +549,7 @@ void T1410Channel::DoOverlap() {
     SaveSTAR = CPU -> STAR -> Gate();
     SaveStorageWrapLatch = CPU -> StorageWrapLatch;
     AChannelSave = CPU -> AChannel -> Selected();
+    SaveStores = TIdleDetector::GetStores();
 
     if((ChOp -> Get().ToInt() & OP_MOD_SYMBOL_W) == OP_MOD_SYMBOL_W) {
         if(ExtEndofTransfer) {
@@ -572,6 +601,12 @@ void T1410Channel::DoOverlap() {
         }
     }
 
+    //  If the overlapped operation just ended, add up how long it took
+
+    if(!ChOverlap -> State()) {
+        OverlapCycles += TVirtualClock::Now() - OverlapStartTime;
+    }
+
     //  Need to mark the assembly channel invalid...
 
 
@@ -581,6 +616,129 @@ void T1410Channel::DoOverlap() {
     CPU -> B_Reg -> Set(SaveBReg);
     CPU -> A_Reg -> Set(SaveAReg);
     CPU -> CycleRing -> Set(SaveCycle);
+    TIdleDetector::SetStores(SaveStores);       //  Not the program's stores
+}
+
+//  Post the next overlap event for this channel, based on what the
+//  device has asked for.  Called after the overlap has been started,
+//  and after each time it is serviced.  If the device has not asked for
+//  anything (e.g., the console waiting on the operator), no event is
+//  posted: the device will post one when it is ready.
+
+void T1410Channel::ScheduleOverlap() {
+
+    long delay;
+
+    if(!ChOverlap -> State()) {
+        OverlapEvent -> Cancel();
+    }
+    else if(ExtEndofTransfer) {
+        OverlapEvent -> Post(OVERLAP_EVENT_END,0);
+    }
+    else if(OutputRequest || CycleRequired || InputRequest) {
+        OverlapEvent -> Post(OVERLAP_EVENT_DATA,CurrentDevice != NULL ?
+            CurrentDevice -> CharacterTime() : OVERLAP_DATA_LATENCY);
+    }
+    else if(UnitControlOverlapBusy != NULL) {
+
+        //  Come back exactly when the unit is no longer busy
+
+        delay = (long) (UnitControlOverlapBusy -> GetBusyUntil() -
+            TVirtualClock::Now());
+        OverlapEvent -> Post(OVERLAP_EVENT_BUSY,delay > 0 ? delay : 0);
+    }
+}
+
+
+
+//  Class TOverlapEvent implementation.  One of these per channel.
+
+TOverlapEvent *TOverlapEvent::FirstEvent = NULL;
+
+TOverlapEvent::TOverlapEvent(T1410Channel *ch) {
+    Channel = ch;
+    NextEvent = NULL;
+    DueTime = 0;
+    Event = OVERLAP_EVENT_NONE;
+    Pending = false;
+}
+
+//  Post an event "delay" storage cycles from now.  A channel only has
+//  one pending event: if one is already pending, the earlier time wins,
+//  and an end of transfer is never downgraded to a data event.
+
+void TOverlapEvent::Post(int event, long delay) {
+
+    __int64 due;
+    TOverlapEvent **pp;
+
+    due = TVirtualClock::Now() + delay;
+
+    if(Pending) {
+        if(event < Event) {
+            event = Event;
+        }
+        if(DueTime <= due) {
+            Event = event;
+            return;
+        }
+        Unlink();
+    }
+
+    DueTime = due;
+    Event = event;
+
+    //  Insert in due time order, after any events due at the same time
+
+    for(pp = &FirstEvent; *pp != NULL && (*pp) -> DueTime <= due;
+        pp = &((*pp) -> NextEvent)) {
+    }
+    NextEvent = *pp;
+    *pp = this;
+    Pending = true;
+}
+
+//  Remove any pending event
+
+void TOverlapEvent::Cancel() {
+    if(Pending) {
+        Unlink();
+    }
+    Event = OVERLAP_EVENT_NONE;
+}
+
+//  Private method to take an event off of the list
+
+void TOverlapEvent::Unlink() {
+
+    TOverlapEvent **pp;
+
+    for(pp = &FirstEvent; *pp != NULL; pp = &((*pp) -> NextEvent)) {
+        if(*pp == this) {
+            *pp = NextEvent;
+            break;
+        }
+    }
+    NextEvent = NULL;
+    Pending = false;
+}
+
+//  Class method to service every event that has come due.  The channel
+//  decides what to post next when its overlap processing is done.
+
+void TOverlapEvent::Service() {
+
+    TOverlapEvent *e;
+
+    while(Due()) {
+        e = FirstEvent;
+        e -> Unlink();
+        e -> Event = OVERLAP_EVENT_NONE;
+        if(e -> Channel -> ChOverlap -> State()) {
+            e -> Channel -> DoOverlap();
+            e -> Channel -> ScheduleOverlap();
+        }
+    }
 }
 
 
@@ -590,6 +748,7 @@ void T1410Channel::DoOverlap() {
 
 T1410IODevice::T1410IODevice(int devicenumber, T1410Channel *Ch) {
     Channel = Ch;
+    DeviceNumber = devicenumber;
     Ch -> AddIODevice(this,devicenumber);
 }
 
@@ -602,6 +761,15 @@ void T1410IODevice::DoUnitControl(BCD opmod) {
     return;
 }
 
+//  Method to return how long, in storage cycles, the device takes to
+//  transfer one character.  Devices without a timing model of their own
+//  (the ones with a buffer, or that go busy for a whole card or line)
+//  just use the default.
+
+long T1410IODevice::CharacterTime() {
+    return(OVERLAP_DATA_LATENCY);
+}
+
 
 
 //  And, finally, the 1410 IO Instruction Routines.  We implement them
@@ -619,6 +787,7 @@ void T1410CPU::InstructionIO() {
 
     BCD opmod;
     T1410Channel *Ch = Channel[IOChannelSelect];
+    __int64 starttime;
 
     opmod = (Op_Mod_Reg -> Get().To6Bit());
     assert(!(Ch -> ChInterlock -> State()));
@@ -691,6 +860,7 @@ void T1410CPU::InstructionIO() {
 
     if(CPU -> IOOverlapSelect) {
         Ch -> ChOverlap -> Set();
+        Ch -> OverlapStartTime = TVirtualClock::Now();
         *(Ch -> ChAddr) = *B_AR;
         Ch -> ChOp -> Set(opmod);
         if((opmod.ToInt() & OP_MOD_SYMBOL_W) == OP_MOD_SYMBOL_W) {
@@ -699,6 +869,7 @@ void T1410CPU::InstructionIO() {
         else if((opmod.ToInt() & OP_MOD_SYMBOL_R) == OP_MOD_SYMBOL_R) {
             Ch -> GetCurrentDevice() -> DoInput();
         }
+        Ch -> ScheduleOverlap();
         IRingControl = true;
         return;
     }
@@ -707,12 +878,19 @@ void T1410CPU::InstructionIO() {
 
     Ch -> ChNotOverlap -> Set();
 
+    //  Since the CPU is stuck here, machine time moves at the speed of
+    //  the device.
+
+    starttime = TVirtualClock::Now();
+
     if((opmod.ToInt() & OP_MOD_SYMBOL_W) == OP_MOD_SYMBOL_W) {
         CPU -> Display();
         while(!Ch -> ExtEndofTransfer) {
             Ch -> DoOutput(B_AR);
+            TVirtualClock::Advance(Ch -> GetCurrentDevice() -> CharacterTime());
         }
         Ch -> ChNotOverlap -> Reset();
+        Ch -> NotOverlapCycles += TVirtualClock::Now() - starttime;
         Ch -> SetStatus(Ch -> GetCurrentDevice() -> StatusSample());
         IRingControl = true;
         return;
@@ -734,6 +912,7 @@ void T1410CPU::InstructionIO() {
                 continue;
             }
 
+            TVirtualClock::Advance(Ch -> GetCurrentDevice() -> CharacterTime());
             Ch -> DoInput(B_AR);
 
         }   //  End, not External End of Transfer
@@ -767,6 +946,7 @@ void T1410CPU::InstructionIO() {
         //  And all done - continue with Instructions
 
         Ch -> ChNotOverlap -> Reset();
+        Ch -> NotOverlapCycles += TVirtualClock::Now() - starttime;
         IRingControl = true;
         return;
     }
@@ -815,8 +995,10 @@ void T1410CPU::InstructionUnitControl() {
     if((opmod.To6Bit() & 0x3f) ==  OP_MOD_SYMBOL_M &&
        CPU -> IOOverlapSelect) {
         Ch -> ChOverlap -> Set();
+        Ch -> OverlapStartTime = TVirtualClock::Now();
         Ch -> ChOp -> Set(opmod);
         Ch -> DoUnitControl(opmod);
+        Ch -> ScheduleOverlap();
         IRingControl = true;
         return;
     }
@@ -855,7 +1037,7 @@ void T1410CPU::InstructionCarriageControl() {
     IOChannelSelect = Op_Reg -> Get().To6Bit() == OP_IO_CARRIAGE_1 ?
         CHANNEL1 : CHANNEL2;
 
-    if(IOChannelSelect > MAXCHANNEL) {
+    if(IOChannelSelect >= Channels) {
        IOInterlockCheck ->
            SetStop("I/O Interlock Check: F/2 Op Channel not implemented");
            return;
@@ -878,10 +1060,13 @@ void T1410CPU::InstructionCarriageControl() {
     //  Check that the device requested exists, and select it.  If anything
     //  goes wrong, return.
 
+    //  F has no unit type in it.  With more than one printer on the
+    //  channel (see UIDEVMAP.h), it goes to the one that printed last.
+
     Ch -> Reset();
     Ch -> ChInterlock -> Set();
-    Channel[IOChannelSelect] -> ChUnitType -> Set(2);       //  Printer is %20
-    Channel[IOChannelSelect] -> ChUnitNumber -> Set(BCD_0); //  Printer is %20
+    Channel[IOChannelSelect] -> ChUnitType -> Set(Ch -> CarriageUnit);
+    Channel[IOChannelSelect] -> ChUnitNumber -> Set(BCD_0); //  Unit 0
     Channel[IOChannelSelect] -> SetCurrentDevice();
     if(Ch -> GetCurrentDevice() == NULL) {
         Ch -> SetStatus(IOCHNOTREADY);
@@ -924,7 +1109,7 @@ void T1410CPU::InstructionSelectStacker() {
     IOChannelSelect = Op_Reg -> Get().To6Bit() == OP_IO_SSF_1 ?
         CHANNEL1 : CHANNEL2;
 
-    if(IOChannelSelect > MAXCHANNEL) {
+    if(IOChannelSelect >= Channels) {
        IOInterlockCheck ->
            SetStop("I/O Interlock Check: K/4 Op Channel not implemented");
            return;
@@ -44,6 +44,7 @@
 #include "UIREADER.h"
 #include "UIPUNCH.h"
 #include "UI1402.h"
+#include "UIDEVMAP.h"
 #include "UI1410PWR.h"
 #include "UI1410DEBUG.h"
 #include "UI1410CPU.h"
@@ -116,6 +117,35 @@ unsigned char sign_negative_table[] = { 0, 0, 1, 0 };
 //  Busy Device List initialization:
 
 TBusyDevice *TBusyDevice::FirstBusyDevice = NULL;
+TBusyDevice **TBusyDevice::BusyHeap = NULL;
+int TBusyDevice::BusyHeapSize = 0;
+int TBusyDevice::BusyHeapCapacity = 0;
+int TBusyDevice::BusyDeviceCount = 0;
+
+//  Virtual clock initialization
+
+__int64 TVirtualClock::Cycles = 0;
+
+//  Idle detector initialization
+
+long TIdleDetector::Stores = 0;
+long TIdleDetector::Instructions = 0;
+long TIdleDetector::PollAddress = -1;
+long TIdleDetector::PollStores = 0;
+long TIdleDetector::PollInstructions = 0;
+bool TIdleDetector::PollBranched = false;
+int TIdleDetector::Passes = 0;
+long TIdleDetector::FastForwards = 0;
+__int64 TIdleDetector::CyclesSkipped = 0;
+
+//  Pacer initialization
+
+int TPacer::Rate = 0;
+__int64 TPacer::BaseCycles = 0;
+unsigned long TPacer::BaseTicks = 0;
+__int64 TPacer::NextCheck = 0;
+long TPacer::Drift = 0;
+long TPacer::MaxLag = 0;
 
 //	Implementation of TCpuObject (Abstract Base Class)
 
@@ -132,24 +162,75 @@ TCpuObject::TCpuObject()
 //  Implementation of TBusyDevice - busy devices list
 
 
-//  Constructor -- adds itself to the list
+//  Constructor -- adds itself to the list, and makes sure the heap has
+//  room for one more.
 
 TBusyDevice::TBusyDevice() {
+
+    TBusyDevice **heap;
+    int i;
+
     NextBusyDevice = FirstBusyDevice;
     FirstBusyDevice = this;
-    BusyTime = 0;
+    BusyUntil = 0;
+    HeapIndex = -1;
+
+    if(++BusyDeviceCount > BusyHeapCapacity) {
+        BusyHeapCapacity = (BusyHeapCapacity == 0) ?
+            BUSYHEAPSIZE : 2 * BusyHeapCapacity;
+        heap = new TBusyDevice *[BusyHeapCapacity];
+        for(i=0; i < BusyHeapSize; ++i) {
+            heap[i] = BusyHeap[i];
+        }
+        delete[] BusyHeap;
+        BusyHeap = heap;
+    }
 }
 
+//  Set the device busy for "time" milliseconds of machine time from now.
+//  0 means not busy at all.
 
-//  Class method to make a pass thru the busy list
+void TBusyDevice::SetBusy(long time) {
+    SetBusyCycles(time * BUSY_CYCLES_PER_MS);
+}
 
-void TBusyDevice::BusyPass() {
-    TBusyDevice *p;
-    for(p = FirstBusyDevice; p != NULL; p = p -> NextBusyDevice) {
-        if(p -> BusyTime != 0) {
-            --(p -> BusyTime);
+//  Same, but in storage cycles, for devices that have a timing model
+//  finer than a millisecond (tape, for example).
+
+void TBusyDevice::SetBusyCycles(long cycles) {
+
+    if(cycles <= 0) {
+        BusyUntil = 0;
+        if(HeapIndex >= 0) {
+            HeapRemove(HeapIndex);
         }
+        return;
+    }
+
+    BusyUntil = TVirtualClock::Now() + cycles;
+
+    if(HeapIndex >= 0) {                    //  Already in heap, just move
+        HeapUp(HeapIndex);
+        HeapDown(HeapIndex);
+        return;
+    }
+
+    assert(BusyHeapSize < BusyHeapCapacity);
+    HeapIndex = BusyHeapSize++;
+    BusyHeap[HeapIndex] = this;
+    HeapUp(HeapIndex);
+}
+
+//  Class method to return the virtual time the next busy device will
+//  be free.  Devices that are already free are dropped from the heap
+//  along the way.  Returns 0 if nothing is busy.
+
+__int64 TBusyDevice::NextFree() {
+
+    while(BusyHeapSize > 0 && !BusyHeap[0] -> TestBusy()) {
+        HeapRemove(0);
     }
+    return(BusyHeapSize > 0 ? BusyHeap[0] -> BusyUntil : 0);
 }
 
 //  Class method to reset all of the busy times to 0
@@ -157,8 +238,174 @@ void TBusyDevice::BusyPass() {
 void TBusyDevice::Reset() {
     TBusyDevice *p;
     for(p = FirstBusyDevice; p != NULL; p = p -> NextBusyDevice) {
-        p -> BusyTime = 0;
+        p -> BusyUntil = 0;
+        p -> HeapIndex = -1;
+    }
+    BusyHeapSize = 0;
+}
+
+//  Private class methods to maintain the heap
+
+void TBusyDevice::HeapSwap(int i, int j) {
+    TBusyDevice *t = BusyHeap[i];
+    BusyHeap[i] = BusyHeap[j];
+    BusyHeap[j] = t;
+    BusyHeap[i] -> HeapIndex = i;
+    BusyHeap[j] -> HeapIndex = j;
+}
+
+void TBusyDevice::HeapUp(int i) {
+    while(i > 0 &&
+        BusyHeap[(i-1)/2] -> BusyUntil > BusyHeap[i] -> BusyUntil) {
+        HeapSwap(i,(i-1)/2);
+        i = (i-1)/2;
+    }
+}
+
+void TBusyDevice::HeapDown(int i) {
+
+    int child;
+
+    while((child = 2*i + 1) < BusyHeapSize) {
+        if(child+1 < BusyHeapSize &&
+            BusyHeap[child+1] -> BusyUntil < BusyHeap[child] -> BusyUntil) {
+            ++child;
+        }
+        if(BusyHeap[i] -> BusyUntil <= BusyHeap[child] -> BusyUntil) {
+            break;
+        }
+        HeapSwap(i,child);
+        i = child;
+    }
+}
+
+void TBusyDevice::HeapRemove(int i) {
+
+    TBusyDevice *p = BusyHeap[i];
+
+    if(i != --BusyHeapSize) {
+        HeapSwap(i,BusyHeapSize);
+        HeapUp(i);
+        HeapDown(i);
+    }
+    p -> HeapIndex = -1;
+}
+
+
+//  Implementation of TIdleDetector
+
+//  Called by a branch instruction that tests only channel state.
+//  "address" identifies the instruction (its NSI address will do).
+
+void TIdleDetector::Poll(long address, bool branched) {
+
+    if(address == PollAddress && branched == PollBranched &&
+       Stores == PollStores &&
+       Instructions - PollInstructions <= IDLE_MAX_INSTRUCTIONS) {
+        if(++Passes >= IDLE_MIN_PASSES) {
+            FastForward();
+            Passes = 0;
+        }
     }
+    else {
+        Passes = 0;
+    }
+
+    PollAddress = address;
+    PollBranched = branched;
+    PollStores = Stores;
+    PollInstructions = Instructions;
+}
+
+//  Private method to move the clock ahead to the next time a busy
+//  device frees up, or a channel has an overlap event, whichever comes
+//  first.  If there is neither, the program is waiting on the operator,
+//  and it can just keep spinning.
+
+void TIdleDetector::FastForward() {
+
+    __int64 next, now;
+
+    now = TVirtualClock::Now();
+    next = TBusyDevice::NextFree();
+    if(TOverlapEvent::FirstEvent != NULL &&
+       (next == 0 || TOverlapEvent::FirstEvent -> GetDueTime() < next)) {
+        next = TOverlapEvent::FirstEvent -> GetDueTime();
+    }
+
+    if(next > now) {
+        TVirtualClock::AdvanceTo(next);
+        ++FastForwards;
+        CyclesSkipped += next - now;
+    }
+}
+
+//  Reset the statistics (and forget any loop in progress)
+
+void TIdleDetector::Reset() {
+    PollAddress = -1;
+    Passes = 0;
+    FastForwards = 0;
+    CyclesSkipped = 0;
+}
+
+//  Implementation of TPacer - holds the CPU to a multiple of real speed
+
+//  Set the speed multiple.  0 means run as fast as we can.
+
+void TPacer::SetRate(int n) {
+    Rate = (n < 0) ? 0 : n;
+    Resync();
+}
+
+//  Start pacing over again from right now (e.g., at START), and clear
+//  the drift statistics.
+
+void TPacer::Resync() {
+    BaseCycles = TVirtualClock::Now();
+    BaseTicks = GetTickCount();
+    NextCheck = BaseCycles +
+        (__int64) PACE_QUANTUM_MS * BUSY_CYCLES_PER_MS * (Rate ? Rate : 1);
+    Drift = MaxLag = 0;
+}
+
+//  Compare machine time against host time.  If we are ahead, sleep (in
+//  chunks, so that Windoze still gets to breathe and STOP still works).
+//  If we are too far behind, write the time off and start over.
+
+void TPacer::Check() {
+
+    long machine, host, lead;
+    long drift, maxlag;
+
+    for(;;) {
+        machine = (long) ((TVirtualClock::Now() - BaseCycles) /
+            ((__int64) BUSY_CYCLES_PER_MS * Rate));
+        host = (long) (GetTickCount() - BaseTicks);
+        lead = machine - host;
+
+        if(lead <= 0 || CPU -> StopKeyLatch) {
+            break;
+        }
+        Sleep(lead > PACE_SLEEP_MS ? PACE_SLEEP_MS : lead);
+        Application -> ProcessMessages();
+    }
+
+    if(-lead > MaxLag) {
+        MaxLag = -lead;
+    }
+
+    if(-lead > PACE_MAX_LAG_MS) {
+        drift = Drift - lead;
+        maxlag = MaxLag;
+        Resync();
+        Drift = drift;
+        MaxLag = maxlag;
+        return;
+    }
+
+    NextCheck = TVirtualClock::Now() +
+        (__int64) PACE_QUANTUM_MS * BUSY_CYCLES_PER_MS * Rate;
 }
 
 
@@ -235,7 +482,7 @@ void TDisplayLatch::SetStop(char const *msg) {
 
 void TDisplayLatch::Display()
 {
-    if(lamp -> Enabled != state) {
+    if(lamp != NULL && lamp -> Enabled != state) {
         lamp -> Enabled = state;
         lamp -> Repaint();
     }
@@ -246,6 +493,9 @@ void TDisplayLatch::Display()
 
 void TDisplayLatch::LampTest(bool b)
 {
+	if(lamp == NULL) {                          //  Not every latch has one
+		return;
+	}
 	lamp -> Enabled = (b ? true : state);
     lamp -> Repaint();
 }
@@ -627,6 +877,8 @@ BCD TAChannel::Select()
 
 BCD TAChannel::Select(enum TAChannelSelect sel)
 {
+	int ch;
+
 	AChannelSelect = sel;
 
     switch(AChannelSelect) {
@@ -638,14 +890,16 @@ BCD TAChannel::Select(enum TAChannelSelect sel)
     case A_Channel_Mod:
     	return(CPU -> Op_Mod_Reg -> Get());
     case A_Channel_E:
-    	return(CPU -> Channel[CHANNEL1] -> ChR2 -> Get());
     case A_Channel_F:
-    	if(MAXCHANNEL > 1) {
-        	return(CPU -> Channel[CHANNEL2] -> ChR2 -> Get());
+    case A_Channel_G:
+    case A_Channel_H:
+    	ch = AChannelSelect - A_Channel_E;
+    	if(ch < CPU -> Channels) {
+        	return(CPU -> Channel[ch] -> ChR2 -> Get());
         }
         else {
         	CPU -> ACharacterSelectCheck ->
-            	SetStop("A Character Select Check: Channel 2, only 1 configured");
+            	SetStop("A Character Select Check: Channel not configured");
             return(0);
         }
     default:
@@ -679,9 +933,9 @@ void TAChannel::Display()
     	lamps[2] -> Enabled = true;
         break;
     case A_Channel_F:
-    	if(MAXCHANNEL > 1) {
-        	lamps[3] -> Enabled = true;
-        }
+        lamps[3] -> Enabled = true;
+        break;
+    default:                                    //  G and H have no lamps
         break;
     }
 
@@ -1120,6 +1374,7 @@ T1410CPU::T1410CPU()
     IOChannelSelect = false;
     IndexLatches = 0;
     InqReqLatch = false;
+    JobStartTime = -1;
 
     CarryIn = new TDisplayLatch(F1415L -> Light_Carry_In,false);
     CarryOut = new TDisplayLatch(F1415L -> Light_Carry_Out,false);
@@ -1233,7 +1488,18 @@ T1410CPU::T1410CPU()
     TOD = new TAddressRegister();
     TOD -> Reset();
 
-    //	Build the channels
+    //	Build the channels.  The device map says how many there are.
+    //  Channels 1 and 2 have their lights on the 1415.  Channels 3 and 4
+    //  (on a 7010) have none, and an address register of their own.
+
+    Channels = DEFAULT_CHANNELS;
+    if(FileExists(DEVMAP_FILE)) {
+        Channels = TDeviceMap::ChannelCount(DEVMAP_FILE);
+    }
+
+    for(i=0; i < MAXCHANNEL; ++i) {
+        Channel[i] = NULL;
+    }
 
     Channel[CHANNEL1] = new T1410Channel(
         E_AR,
@@ -1267,6 +1533,16 @@ T1410CPU::T1410CPU()
         F1415L -> Light_Ch2_NoTransfer
     );
 
+    for(i=CHANNEL3; i < Channels; ++i) {
+        Channel[i] = new T1410Channel(new TAddressRegister(),
+            NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL);
+        Channel[i] -> ChAddr -> Reset();
+    }
+
+    for(i=0; i < Channels; ++i) {
+        Channel[i] -> Number = i;
+    }
+
     //	Build the A Channel and Assembly Channel
 
     AChannel = new TAChannel();
@@ -1317,14 +1593,17 @@ T1410CPU::T1410CPU()
         new TPunch(PUNCH_IO_DEVICE, CPU -> Channel[CHANNEL1]);
     FI1402 -> Channel = CPU -> Channel[CHANNEL1];
 
-    FI729 -> SetTAU(new TTapeTAU(TAPE_IO_DEVICE,CPU -> Channel[CHANNEL1]),
-        CHANNEL1);
-    if(MAXCHANNEL > 1) {
-        FI729 -> SetTAU(new TTapeTAU(TAPE_IO_DEVICE,CPU -> Channel[CHANNEL2]),
-        CHANNEL2);
+    for(i=0; i < Channels; ++i) {
+        FI729 -> SetTAU(new TTapeTAU(TAPE_IO_DEVICE,CPU -> Channel[i]),i);
     }
     FI729 -> Display();
 
+    //  And any more that the device map asks for
+
+    if(FileExists(DEVMAP_FILE)) {
+        TDeviceMap::Load(DEVMAP_FILE);
+    }
+
 }
 
 
@@ -1410,6 +1689,10 @@ void T1410CPU::Readout()
 {
 	long i;
 
+    //  Every readout is one storage cycle of machine time
+
+    TVirtualClock::Tick();
+
     //	Get the contents of STAR: The Memory Address Register
 
     i = STAR -> Gate();			//  Hee hee  ;-)  A Punny
@@ -1474,6 +1757,7 @@ void T1410CPU::Store(BCD bcd)
     }
 
     core[i] = bcd;
+    TIdleDetector::Store();
 }
 
 //	Set Storage Scan Mode
@@ -88,15 +88,96 @@ public:
 
 
 
+//  Virtual machine clock.  Counts 1410 storage cycles (4.5 microseconds
+//  each) since power on.  The clock is advanced by the CPU every time it
+//  reads out core, so it is independent of how fast (or slow) the host
+//  happens to be running us.  Anything that wants to happen at a
+//  deterministic machine time (overlap events, for example) is scheduled
+//  against this clock.  It is never reset, so it can only move forward.
+
+#define CYCLE_NS    4500                    //  Storage cycle, nanoseconds
+
+class TVirtualClock {
+
+private:
+
+    static __int64 Cycles;                  //  Storage cycles so far
+
+public:
+
+    static inline __int64 Now() { return Cycles; }
+    static inline void Tick() { ++Cycles; }
+    static inline void Advance(long n) { Cycles += n; }
+    static inline void AdvanceTo(__int64 t) { if(t > Cycles) Cycles = t; }
+
+    //  Conversions between real time and storage cycles (rounded)
+
+    static inline long FromMicroseconds(long us) {
+        return((long) (((__int64) us * 1000 + CYCLE_NS/2) / CYCLE_NS));
+    }
+    static inline long FromNanoseconds(long ns) {
+        return((long) (((__int64) ns + CYCLE_NS/2) / CYCLE_NS));
+    }
+    static inline double Seconds(__int64 c) {
+        return((double) c * CYCLE_NS / 1.0e9);
+    }
+};
+
+//  Pacing.  Normally the emulator runs as fast as it can.  The pacer can
+//  instead hold it to the speed of a real 1410 (or some multiple of it),
+//  by comparing the virtual clock against the host clock.  It only checks
+//  every PACE_QUANTUM_MS of machine time, and then sleeps off however far
+//  ahead we are, so it does not eat the host CPU.  If we fall behind (the
+//  host is too slow, or the debugger stopped us) by more than
+//  PACE_MAX_LAG_MS, it gives up on catching up and starts over from
+//  there, and counts the time lost as drift.
+
+#define PACE_QUANTUM_MS     20              //  Check this often
+#define PACE_SLEEP_MS       50              //  Longest single sleep
+#define PACE_MAX_LAG_MS     500             //  Resync if this far behind
+
+class TPacer {
+
+private:
+
+    static int Rate;                        //  Multiple, 0 = unthrottled
+    static __int64 BaseCycles;              //  Virtual clock at resync
+    static unsigned long BaseTicks;         //  Host clock (ms) at resync
+    static __int64 NextCheck;               //  When to check next
+    static long Drift;                      //  Time lost (ms) since reset
+    static long MaxLag;                     //  Furthest behind (ms)
+
+public:
+
+    static void SetRate(int n);             //  Set multiple, 0 = no pacing
+    static inline int GetRate() { return Rate; }
+    static void Resync();                   //  Start over from now
+    static inline void Pace() {             //  Called often by the CPU
+        if(Rate != 0 && TVirtualClock::Now() >= NextCheck) {
+            Check();
+        }
+    }
+    static void Check();                    //  Sleep off any lead
+    static inline long GetDrift() { return Drift; }
+    static inline long GetMaxLag() { return MaxLag; }
+};
+
+
 //  Busy list object.  Each represents some device/unit that can
 //  be busy for a while.  During it's constructor, device can request
-//  an entry.  When a device wants to by busy for a while, it can
-//  set it's counter.  We will pretend that the counter represents the
-//  number of milliseconds the device wants to pretend it is busy.
-//  But, for now, every "n" cycles, the CPU will go thru the list, and
-//  decrement any non-zero ones.  A device can then check it's entry,
-//  to know if it should still pretend it is busy, or not.  Eventually,
-//  a real time element might well be introduced.
+//  an entry.  When a device wants to by busy for a while, it calls
+//  SetBusy with the number of milliseconds it wants to pretend it is
+//  busy.  That is turned into an absolute time on the virtual clock
+//  when the device will be free again, so testing for busy is just a
+//  comparison.  Busy devices are also kept in a heap, ordered by when
+//  they will be free, so that anyone waiting on a device (the channel,
+//  for example) can find out when the next one frees up without
+//  going thru the whole list.  The heap grows as devices are added (the
+//  device map can add any number of them), so it always has room for
+//  every one of them at once.
+
+#define BUSY_CYCLES_PER_MS  222             //  1 / (.0045ms == 4.5us)
+#define BUSYHEAPSIZE        64              //  Initial heap size
 
 class TBusyDevice {
 
@@ -106,18 +187,71 @@ public:
 
 private:
 
+    static TBusyDevice **BusyHeap;          //  Min heap on BusyUntil
+    static int BusyHeapSize;
+    static int BusyHeapCapacity;            //  Room in it
+    static int BusyDeviceCount;             //  Entries on the list
+
 	TBusyDevice *NextBusyDevice;            //  Next entry in the list
-    long BusyTime;                          //  How long to be busy for
+    __int64 BusyUntil;                      //  Virtual time free again
+    int HeapIndex;                          //  Where in heap, -1 if not
+
+    static void HeapSwap(int i, int j);
+    static void HeapUp(int i);
+    static void HeapDown(int i);
+    static void HeapRemove(int i);
 
 public:
 
     TBusyDevice();                          //  Constructor.
-    void SetBusy(long time) { BusyTime = time ? (time+1) : 0; };
-    bool TestBusy() { return(BusyTime != 0); };
-    static void BusyPass();             //  CLASS METHOD - pass the list
+    void SetBusy(long time);                //  Busy for time milliseconds
+    void SetBusyCycles(long cycles);        //  Busy for storage cycles
+    inline bool TestBusy() { return(BusyUntil > TVirtualClock::Now()); };
+    inline __int64 GetBusyUntil() { return BusyUntil; };
+    static __int64 NextFree();          //  CLASS METHOD - next free time
     static void Reset();                //  Resets list to all NOT busy
 };
 
+//  Idle detector.  Programs often sit in a tight loop testing a channel
+//  (branch if busy, branch if still overlapped) while a tape rewinds or
+//  the printer skips.  Branch instructions that test only channel state
+//  report in here.  If the same one comes around again within a few
+//  instructions, with the same outcome and nothing stored in between,
+//  the machine cannot change what it is doing until some device or
+//  channel does.  So the clock just jumps ahead to the next time that
+//  happens.  (Stores made by an overlapped channel do not count - they
+//  are not the program's).
+
+#define IDLE_MAX_INSTRUCTIONS   8           //  Longest loop we look for
+#define IDLE_MIN_PASSES         3           //  Times around before we jump
+
+class TIdleDetector {
+
+private:
+
+    static long Stores;                     //  Program stores so far
+    static long Instructions;               //  Instructions so far
+    static long PollAddress;                //  Last polling branch (NSI)
+    static long PollStores;                 //  Stores at that time
+    static long PollInstructions;           //  Instructions at that time
+    static bool PollBranched;               //  What that branch did
+    static int Passes;                      //  Times around the loop
+
+    static void FastForward();
+
+public:
+
+    static long FastForwards;               //  Statistics
+    static __int64 CyclesSkipped;
+
+    static inline void Store() { ++Stores; }
+    static inline void Instruction() { ++Instructions; }
+    static inline long GetStores() { return Stores; }
+    static inline void SetStores(long n) { Stores = n; }
+    static void Poll(long address, bool branched);
+    static void Reset();
+};
+
 //	Class TDisplayObjects are indicators:  They just
 //	display other things.  As a result, they need a pointer to
 //	a function returning bool in order to decide what to do.
@@ -324,8 +458,13 @@ class TAChannel : public TDisplayObject {
 
 public:
 
+	//	E and F are the channel 1 and 2 registers.  G and H are channels
+	//	3 and 4, which only a 7010 style machine has (and which have no
+	//	lights on the CE panel).  They have to stay in channel order.
+
 	enum TAChannelSelect { A_Channel_None = 0, A_Channel_A = 1,
-    	A_Channel_Mod = 2, A_Channel_E = 3, A_Channel_F = 4 };
+    	A_Channel_Mod = 2, A_Channel_E = 3, A_Channel_F = 4,
+        A_Channel_G = 5, A_Channel_H = 6 };
 
 private:
 
@@ -446,9 +585,16 @@ class T1410Channel;
 
 //	This class defines what is actually inside the CPU.
 
-#define MAXCHANNEL 2
+//	A 1410 has 2 I/O channels.  A 7010 could have up to 4, so there is room
+//	for that many.  How many there really are is up to the device map (see
+//	UIDEVMAP), and kept in CPU -> Channels.
+
+#define MAXCHANNEL 4
+#define DEFAULT_CHANNELS 2
 #define CHANNEL1 0
 #define CHANNEL2 1
+#define CHANNEL3 2
+#define CHANNEL4 3
 
 #define STORAGE 80000
 
@@ -535,7 +681,8 @@ public:
 
     //	Channels
 
-    T1410Channel *Channel[MAXCHANNEL];		// 2 I/O Channels.
+    T1410Channel *Channel[MAXCHANNEL];		// I/O Channels
+    int Channels;                           // How many are installed
 
     TAChannel *AChannel;					// A Channel
 	TAssemblyChannel *AssemblyChannel;		// Assembly Channel
@@ -640,10 +787,12 @@ public:
 
     bool StorageWrapLatch;                  //  True if storage wrapped
 
-    int IOChannelSelect;					//	One if  if channel 2 op.
+    int IOChannelSelect;					//	Channel, origin 0
     bool IOOverlapSelect;                   //  True if overlap (A bit)
     bool InqReqLatch;                       //  True if outstanding inquiry
 
+    __int64 JobStartTime;                   //  Virtual time at Start, or -1
+
     //	Index latches are rolled up into an int.  The BA zones from the
     //	tens and hundreds positions are shifted and the 4 bits together
     //	generate a value from 0 to 15.
@@ -709,6 +858,7 @@ public:
     unsigned short OpControlLines;
 
 	void DoStartClick();			//	START pressed (moved from UI1410PWR)
+    void JobReport();               //  Timing report after a run
     void InstructionDecodeStart();	//	Starts instruction decode processing
     void InstructionDecode();		//	Remainder of instruction decode
     void InstructionDecodeIARAdvance();		//	Conditionally advance IAR
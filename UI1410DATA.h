@@ -1,34 +1,34 @@
-//---------------------------------------------------------------------------
-#ifndef UI1410DATAH
-#define UI1410DATAH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-#define SZ_SUPPRESS_IF_ZERO     1
-#define SZ_INCLUDE_IF_ZERO      2
-#define SZ_SIGNIFICANT_DIGIT    4
-
-#define EDIT_SUPPRESS_IF_PLUS   8
-#define EDIT_UNITS_SPECIAL      16
-#define EDIT_EXT_SPECIAL        32
-#define EDIT_BODY_SPECIAL       64
-#define EDIT_SUPPRESS_IF_NS     128
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UI1410DATAH
+#define UI1410DATAH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define SZ_SUPPRESS_IF_ZERO     1
+#define SZ_INCLUDE_IF_ZERO      2
+#define SZ_SIGNIFICANT_DIGIT    4
+
+#define EDIT_SUPPRESS_IF_PLUS   8
+#define EDIT_UNITS_SPECIAL      16
+#define EDIT_EXT_SPECIAL        32
+#define EDIT_BODY_SPECIAL       64
+#define EDIT_SUPPRESS_IF_NS     128
+
+#endif
@@ -21,6 +21,7 @@
 #pragma hdrstop
 
 #include <stdio.h>
+#include <string.h>
 #include "UI1410DEBUG.h"
 //---------------------------------------------------------------------------
 #pragma resource "*.dfm"
@@ -33,6 +34,7 @@ __fastcall TF1410Debug::TF1410Debug(TComponent* Owner)
 	// WindowState = wsMinimized;
 	fileName = L"";
 	debugFd = NULL;
+	DebugNext = DebugNew = DebugShown = 0;
 
 	fileNameLabel -> Caption = L"";
 	fileButton -> Caption = L"File...";
@@ -43,16 +45,97 @@ __fastcall TF1410Debug::TF1410Debug(TComponent* Owner)
 
 void TF1410Debug::DebugOut(char const *s)
 {
-    if(Debug -> Lines -> Capacity > 512) {
-        Debug -> Lines -> Delete(0);
-    }
-	Debug -> Lines -> Add(s);
+	strncpy(DebugRing[DebugNext],s,DEBUGMAXLINE-1);
+	DebugRing[DebugNext][DEBUGMAXLINE-1] = '\0';
+	DebugNext = (DebugNext + 1) % DEBUGMAXLINES;
+	++DebugNew;
+
 	if(debugFd != NULL) {
 		debugFd -> Write(s,strlen(s));
 		debugFd -> Write("\r\n",2);
     }
 }
 
+//	Bring the debug window up to date from the ring, if there is anything
+//	new.
+
+void __fastcall TF1410Debug::DebugTimerTimer(TObject *Sender)
+{
+	RingToMemo(Debug,&DebugRing[0][0],DEBUGMAXLINE,DEBUGMAXLINES,
+		DebugNext,DebugNew,DebugShown,DebugLength);
+}
+
+//	Bring a memo up to date from a ring of lines (the debug window, and
+//	the 1403's paper).  The ring has "lines" slots, each "width" characters
+//	(counting the '\0'), and "next" is the slot the next line goes in.
+//	"fresh" lines are not in the memo yet, and "shown" lines are, and
+//	"length" has how long each shown line is in the memo, with its CR LF.
+//
+//	The new lines go on the end.  The oldest lines in the memo (as many as
+//	the ring no longer has room for) come off the top:  that is what the
+//	lengths are for, since their slots in the ring now have new lines in
+//	them.  If every line is new, it is quicker to just replace the lot.
+
+void RingToMemo(TMemo *memo, char const *ring, int width, int lines,
+	int next, int &fresh, int &shown, int *length)
+{
+	char *text, *cp;
+	char const *slot;
+	int i, line, drop, n;
+	long cut = 0;
+
+	if(fresh == 0) {
+		return;
+	}
+	if(fresh > lines) {
+		fresh = lines;
+	}
+
+	drop = shown + fresh - lines;
+	if(drop < 0) {
+		drop = 0;
+	}
+	line = (next - fresh - shown + 2 * lines) % lines;
+	for(i=0; i < drop; ++i) {
+		cut += length[line];
+		line = (line + 1) % lines;
+	}
+
+	cp = text = new char[lines * (width + 1) + 1];
+	line = (next - fresh + lines) % lines;
+	for(i=0; i < fresh; ++i) {
+		slot = ring + line * width;
+		n = strlen(slot);
+		memcpy(cp,slot,n);
+		cp += n;
+		*cp++ = '\r';
+		*cp++ = '\n';
+		length[line] = n + 2;
+		line = (line + 1) % lines;
+	}
+	*cp = '\0';
+
+	memo -> Lines -> BeginUpdate();
+	if(drop == shown) {
+		memo -> Lines -> Text = text;
+	}
+	else {
+		if(cut > 0) {
+			memo -> SelStart = 0;
+			memo -> SelLength = cut;
+			memo -> SelText = "";
+		}
+		memo -> SelStart = memo -> GetTextLen();
+		memo -> SelText = text;
+	}
+	memo -> Lines -> EndUpdate();
+	delete[] text;
+
+	shown += fresh - drop;
+	fresh = 0;
+	memo -> Perform(WM_VSCROLL,SB_BOTTOM,0);
+}
+
 void TF1410Debug::Minimize() {
 	WindowState = wsMinimized;
 }
@@ -30,10 +30,18 @@
 //  "legacy" Borland C++ style compiler did not handle it.
 
 #define DEBUG(string, ...) \
-	sprintf(F1410Debug->line,string, ##__VA_ARGS__);	\
+	snprintf(F1410Debug->line,DEBUGMAXLINE,string, ##__VA_ARGS__);	\
 	F1410Debug -> DebugOut(F1410Debug -> line);
 
 
+//  The debug window keeps the last DEBUGMAXLINES lines in a ring, and
+//  DebugTimer brings the window up to date from it when there is something
+//  new, using RingToMemo (which the 1403's paper uses, too).  (The log
+//  file, if any, still gets every line right away).
+
+#define DEBUGMAXLINES   512
+#define DEBUGMAXLINE    256
+
 class TF1410Debug : public TForm
 {
 __published:	// IDE-managed Components
@@ -41,19 +49,30 @@ __published:	// IDE-managed Components
 	TButton *fileButton;
 	TLabel *fileNameLabel;
 	TOpenDialog *FileOpenDialog;
+	TTimer *DebugTimer;
 	void __fastcall fileButtonClick(TObject *Sender);
+	void __fastcall DebugTimerTimer(TObject *Sender);
 private:	// User declarations
 	String fileName;
     TFileStream *debugFd;
 
+    char DebugRing[DEBUGMAXLINES][DEBUGMAXLINE];
+    int DebugNext;                              //  Next line in the ring
+    int DebugNew;                               //  Not in the window yet
+    int DebugShown;                             //  Lines in the window
+    int DebugLength[DEBUGMAXLINES];             //  Each, in window, w/ CRLF
+
 public:		// User declarations
 	__fastcall TF1410Debug(TComponent* Owner);
     TF1410Debug();
-    char line[256];
+    char line[DEBUGMAXLINE];
 	void DebugOut(char const *s);
     void Minimize();
 };
 //---------------------------------------------------------------------------
 extern TF1410Debug *F1410Debug;
+
+void RingToMemo(TMemo *memo, char const *ring, int width, int lines,
+	int next, int &fresh, int &shown, int *length);
 //---------------------------------------------------------------------------
 #endif
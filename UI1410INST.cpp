@@ -30,6 +30,11 @@
 #include "UI1410CHANNEL.h"
 #include "UI1410DEBUG.h"
 #include "UI1410INST.h"
+#include "UITAPEUNIT.h"
+#include "UITAPETAU.h"
+#include "UITAPELIB.h"
+#include "UIREADER.h"
+#include "UIPUNCH.h"
 
 //---------------------------------------------------------------------------
 
@@ -129,10 +134,11 @@ void T1410CPU::DoStartClick()
 {
 
     int refresh = 0;
-    int busybee = 0;
-    int overlapcycle = 0;
     int opcode;
-    int ch;
+    int ch, dev;
+    TTapeTAU *tau;
+    TCardReader *reader;
+    TPunch *punch;
 
 	switch(Mode) {
 
@@ -164,6 +170,32 @@ void T1410CPU::DoStartClick()
         StopLatch = StopKeyLatch = false;
         F1415L -> Light_Stop -> Enabled = false;
 
+        //  Start timing the job, for the report when we stop
+
+        JobStartTime = TVirtualClock::Now();
+        for(ch = 0; ch < Channels; ++ch) {
+            Channel[ch] -> ResetTiming();
+            tau = dynamic_cast<TTapeTAU *>(
+                Channel[ch] -> GetIODevice(TAPE_IO_DEVICE));
+            if(tau != NULL) {
+                tau -> ResetStats();
+            }
+            for(dev = 0; dev < 64; ++dev) {     //  Any number of these
+                reader = dynamic_cast<TCardReader *>(
+                    Channel[ch] -> GetIODevice(dev));
+                if(reader != NULL) {
+                    reader -> ResetStats();
+                }
+                punch = dynamic_cast<TPunch *>(
+                    Channel[ch] -> GetIODevice(dev));
+                if(punch != NULL) {
+                    punch -> ResetStats();
+                }
+            }
+        }
+        TPacer::Resync();
+        TIdleDetector::Reset();
+
         //	These are debugging statements.  I've had a lot of problems
         //	using ptr = ptr instead of *ptr = *ptr
 
@@ -194,16 +226,12 @@ void T1410CPU::DoStartClick()
                 }
             }
 
-            //  See if any of the channels need attention every 12 cycles.
-            //  If so, give them a chance to do their thing.
+            //  If an overlapped channel has an event that has come due,
+            //  give it a chance to do its thing.  (This used to poll
+            //  every channel every 3 passes, whether it needed it or not).
 
-            if(++overlapcycle > 2) {               //  Was 12
-                overlapcycle = 0;
-                for(ch = 0; ch < MAXCHANNEL; ++ch) {
-                    if(Channel[ch] -> ChOverlap -> State()) {
-                        Channel[ch] -> DoOverlap();
-                    }
-                }
+            if(TOverlapEvent::Due()) {
+                TOverlapEvent::Service();
             }
 
     	    if(IRingControl) {
@@ -215,6 +243,7 @@ void T1410CPU::DoStartClick()
                     return;
                 }
         		InstructionDecodeStart();
+                TIdleDetector::Instruction();
             	if(CycleControl != CYCLE_OFF ||
                    (LastInstructionReadout && Mode == MODE_IE)) {
                     F1415L -> Light_Stop -> Enabled = true;
@@ -307,20 +336,14 @@ void T1410CPU::DoStartClick()
 
 		    Application -> ProcessMessages();
 
-            //  See if it is time to reduce the busy count (for debugging)
-            //  The timing here is approximately Milleseconds in machine
-            //  time.  (1 / (.0045ms == 4.5us)) == 222
+            //  If we are running at a fixed speed, hold back if need be
 
-            if(++busybee > 20) {                       //  Was 222
-                busybee = 0;
-                TBusyDevice::BusyPass();
-            }
+            TPacer::Pace();
 
             //  See if a refresh of the display is in order
 
             if(++refresh > 10000) {
                 refresh = 0;
-                TBusyDevice::BusyPass();
                 CPU -> Display();
             }
         }
@@ -333,6 +356,80 @@ void T1410CPU::DoStartClick()
 
 }
 
+//  Job report.  Called after the CPU stops running.  Reports how much
+//  machine time the run took, and, for each channel, how much of its I/O
+//  time the CPU was able to keep on computing (overlap efficiency).
+
+void T1410CPU::JobReport()
+{
+    int ch, dev;
+    __int64 elapsed, io, busy;
+    TTapeTAU *tau;
+    TCardReader *reader;
+    TPunch *punch;
+
+    if(JobStartTime < 0) {
+        return;
+    }
+
+    elapsed = TVirtualClock::Now() - JobStartTime;
+    JobStartTime = -1;
+
+    DEBUG("Job report: %.3f seconds of machine time (%lld storage cycles)",
+        TVirtualClock::Seconds(elapsed),elapsed);
+
+    for(ch = 0; ch < Channels; ++ch) {
+        io = Channel[ch] -> OverlapCycles + Channel[ch] -> NotOverlapCycles;
+        if(io == 0) {
+            continue;
+        }
+        busy = Channel[ch] -> NotOverlapCycles + Channel[ch] -> StallCycles;
+        DEBUG("  Channel %d: I/O %.3f sec, overlapped %.3f sec, "
+            "CPU waited %.3f sec",ch+1,
+            TVirtualClock::Seconds(io),
+            TVirtualClock::Seconds(Channel[ch] -> OverlapCycles),
+            TVirtualClock::Seconds(busy));
+        DEBUG("  Channel %d: overlap efficiency %d%%",ch+1,
+            (int) (busy >= io ? 0 : (100 * (io - busy)) / io));
+    }
+
+    if(TIdleDetector::FastForwards != 0) {
+        DEBUG("  Idle loops skipped %ld times, %.3f sec of machine time",
+            TIdleDetector::FastForwards,
+            TVirtualClock::Seconds(TIdleDetector::CyclesSkipped));
+    }
+
+    if(TPacer::GetRate() != 0) {
+        DEBUG("  Paced at %dX: drift %ld ms, fell behind by at most %ld ms",
+            TPacer::GetRate(),TPacer::GetDrift(),TPacer::GetMaxLag());
+    }
+
+    for(ch = 0; ch < Channels; ++ch) {
+        tau = dynamic_cast<TTapeTAU *>(
+            Channel[ch] -> GetIODevice(TAPE_IO_DEVICE));
+        if(tau != NULL) {
+            tau -> Report(ch);
+        }
+    }
+
+    for(ch = 0; ch < Channels; ++ch) {
+        for(dev = 0; dev < 64; ++dev) {
+            reader = dynamic_cast<TCardReader *>(
+                Channel[ch] -> GetIODevice(dev));
+            if(reader != NULL) {
+                reader -> Report(ch,elapsed);
+            }
+            punch = dynamic_cast<TPunch *>(
+                Channel[ch] -> GetIODevice(dev));
+            if(punch != NULL) {
+                punch -> Report(ch,elapsed);
+            }
+        }
+    }
+
+    TTapeLibrary::Report();
+}
+
 
 
 //	Instruction Decode - initial phase
@@ -709,17 +806,20 @@ void T1410CPU::InstructionDecode()
 
         case I_RING_3:
 
-            //	IO channel/overlap indicator must have 84 bit configuration
+            //	IO channel/overlap indicator must have 84 bit configuration.
+            //  With more than 2 channels, 841 picks channel 3 or 4.
 
-            if((B_Reg -> Get() & BIT_NUM) != 0x0c) {
+            if((B_Reg -> Get() & BIT_NUM) != 0x0c &&
+               (Channels <= CHANNEL3 || (B_Reg -> Get() & BIT_NUM) != 0x0d)) {
             	AddressCheck ->
                 	SetStop("Address Check: I/O Ch/Ovlp must have 84 config");
                 return;
             }
 
-            IOChannelSelect = ((B_Reg -> Get() & BITB) != 0);
+            IOChannelSelect = ((B_Reg -> Get() & BITB) != 0) +
+                ((B_Reg -> Get() & BIT_NUM) == 0x0d ? CHANNEL3 : CHANNEL1);
             IOOverlapSelect = ((B_Reg -> Get() & BITA) == 0);
-            if(IOChannelSelect >= MAXCHANNEL) {
+            if(IOChannelSelect >= Channels) {
                 IOInterlockCheck ->
                     SetStop("I/O Interlock Check: Channel not implemented");
                 return;
@@ -771,7 +871,7 @@ void T1410CPU::InstructionDecode()
         Op_Reg -> Get().To6Bit() != OP_BRANCH_PR &&
         Op_Reg -> Get().To6Bit() != OP_BRANCH_CH_1 &&
         Op_Reg -> Get().To6Bit() != OP_BRANCH_CH_2) {
-        for(Ch = 0; Ch < MAXCHANNEL; ++Ch) {
+        for(Ch = 0; Ch < Channels; ++Ch) {
             if(Channel[Ch] -> PriorityRequest != 0) {
                 PriorityAlert -> Reset();
                 A_AR -> Set(101);
@@ -0,0 +1,252 @@
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <dir.h>
+#include <stdio.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UIHOPPER.h"
+#include "UI1410CHANNEL.h"
+#include "UIPRINTER.h"
+#include "UIREADER.h"
+#include "UIPUNCH.h"
+#include "UIDEVMAP.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+
+//  Device Map Implementation
+
+//  Find the channel count in the device map.  It has to be known before
+//  anything else (channels first, then the devices on them), so this is a
+//  quick pass over the file just for that.
+
+int TDeviceMap::ChannelCount(String filename) {
+
+    TStringList *lines;
+    String line;
+    int i, n, channels = DEFAULT_CHANNELS;
+
+    lines = new TStringList();
+    try {
+        lines -> LoadFromFile(filename);
+    }
+    catch(Exception &e) {
+        delete lines;
+        return(channels);                       //  Load will complain
+    }
+
+    for(i=0; i < lines -> Count; ++i) {
+        line = StringReplace(lines -> Strings[i],"\t"," ",
+            TReplaceFlags() << rfReplaceAll).Trim();
+        if(line.Length() > 9 && SameText(line.SubString(1,9),"CHANNELS ")) {
+            n = StrToIntDef(line.SubString(10,line.Length()).Trim(),0);
+            if(n < DEFAULT_CHANNELS || n > MAXCHANNEL) {
+                DEBUG("Device map: line %d: channels must be %d to %d",i+1,
+                    DEFAULT_CHANNELS,MAXCHANNEL);
+            }
+            else {
+                channels = n;
+            }
+        }
+    }
+
+    delete lines;
+    DEBUG("Device map: %d I/O channels",channels);
+    return(channels);
+}
+
+//  Load the device map, attaching each device as it goes.  Returns false if
+//  the file could not be read, or had errors in it (the good lines are
+//  still used).
+
+bool TDeviceMap::Load(String filename) {
+
+    TStringList *lines;
+    String line, word[4];
+    int i, n, p, ch, type;
+    bool ok = true;
+
+    lines = new TStringList();
+    try {
+        lines -> LoadFromFile(filename);
+    }
+    catch(Exception &e) {
+        DEBUG("Device map: cannot read %s",AnsiString(filename).c_str());
+        delete lines;
+        return(false);
+    }
+
+    for(i=0; i < lines -> Count; ++i) {
+
+        //  Split the line into (up to) 4 words.  The last one gets the
+        //  rest of the line, so a path can have blanks in it.
+
+        line = StringReplace(lines -> Strings[i],"\t"," ",
+            TReplaceFlags() << rfReplaceAll).Trim();
+        if(line.Length() == 0 || line[1] == '*' || line[1] == ';') {
+            continue;
+        }
+        for(n=0; n < 4 && line.Length() > 0; ++n) {
+            p = line.Pos(" ");
+            if(p == 0 || n == 3) {
+                word[n] = line;
+                line = "";
+            }
+            else {
+                word[n] = line.SubString(1,p-1);
+                line = line.SubString(p+1,line.Length()).Trim();
+            }
+        }
+
+        //  The channel count was taken care of by ChannelCount
+
+        if(SameText(word[0],"CHANNELS") && n == 2) {
+            continue;
+        }
+
+        //  The unit type is a single character, which has to be a valid
+        //  BCD character, and not one that is already in use.
+
+        ch = StrToIntDef(word[1],0) - 1;
+        type = -1;
+        if(n == 4 && word[2].Length() == 1 && word[2][1] < 128) {
+            type = BCD::BCDCheck((char) word[2][1]);
+        }
+        if(type >= 0) {
+            type &= 077;
+        }
+
+        if(n != 4) {
+            DEBUG("Device map: line %d: not understood",i+1);
+            ok = false;
+        }
+        else if(ch < 0 || ch >= CPU -> Channels || type < 0 ||
+            CPU -> Channel[ch] -> GetIODevice(type) != NULL) {
+            DEBUG("Device map: line %d: bad channel or unit type, "
+                "or unit type already in use",i+1);
+            ok = false;
+        }
+        else if(SameText(word[0],"PRINTER") && ch >= CHANNEL3) {
+            DEBUG("Device map: line %d: printers must be on channel 1 or 2 "
+                "(for carriage control)",i+1);
+            ok = false;
+        }
+        else if(!Attach(word[0],ch,type,word[3])) {
+            DEBUG("Device map: line %d: cannot attach %s",i+1,
+                AnsiString(word[0]).c_str());
+            ok = false;
+        }
+    }
+
+    delete lines;
+    return(ok);
+}
+
+//  Private method to check that a device's file can be opened, before the
+//  device is built.  (Once it is built, it is on the channel for good.)
+
+bool TDeviceMap::CanOpen(String path, bool output) {
+
+    TFileStream *fd;
+
+    if(path.Length() == 0 || path.Length() >= MAXPATH) {
+        return(false);
+    }
+    try {
+        fd = new TFileStream(path,output ? fmCreate : fmOpenRead);
+        delete fd;
+    }
+    catch(Exception &e) {
+        return(false);
+    }
+    return(true);
+}
+
+//  Private method to attach one device.  Readers and punches get a set of
+//  hoppers of their own.  Everything that can fail is checked before the
+//  device is built, so a line that fails leaves nothing behind.
+
+bool TDeviceMap::Attach(String kind, int ch, int type, String path)
+{
+    T1410Channel *channel = CPU -> Channel[ch];
+    T1403Printer *printer;
+    TCardReader *reader;
+    TPunch *punch;
+    THopper **hoppers;
+    long cards;
+    int i;
+
+    if(!SameText(kind,"PRINTER") && !SameText(kind,"READER") &&
+       !SameText(kind,"PUNCH")) {
+        return(false);
+    }
+
+    if(SameText(kind,"PRINTER")) {
+        if(!CanOpen(path,true)) {
+            return(false);
+        }
+        printer = new T1403Printer(type,channel);
+        printer -> Unattended();
+        printer -> FileCaptureSet(path);
+        printer -> FileCaptureOpen();
+        DEBUG("Device map: printer %c on channel %d prints to %s",
+            BCD(type).ToAscii(),ch+1,
+            AnsiString(path).c_str());
+        return(true);
+    }
+
+    if(SameText(kind,"READER") ? !CanOpen(path,false) :
+        (!CanOpen(path,true) || !CanOpen(path + ".4",true) ||
+         !CanOpen(path + ".8",true))) {
+        return(false);
+    }
+
+    hoppers = new THopper *[DEVMAP_HOPPERS];
+    for(i=0; i < DEVMAP_HOPPERS; ++i) {
+        hoppers[i] = new THopper();
+    }
+
+    if(SameText(kind,"READER")) {
+        reader = new TCardReader(type,channel);
+        reader -> Unattended(hoppers);
+        reader -> LoadFile(path);
+        cards = reader -> GetDeck() != NULL ?
+            reader -> GetDeck() -> GetCount() : 0;
+        reader -> SetEOF();
+        reader -> DoStart();
+        DEBUG("Device map: reader %c on channel %d reads %s (%ld cards)",
+            BCD(type).ToAscii(),ch+1,AnsiString(path).c_str(),cards);
+        return(true);
+    }
+
+    hoppers[HOPPER_P0] -> setFilename(path);
+    hoppers[HOPPER_P4] -> setFilename(path + ".4");
+    hoppers[HOPPER_P8] -> setFilename(path + ".8");
+    punch = new TPunch(type,channel);
+    punch -> Unattended(hoppers);
+    DEBUG("Device map: punch %c on channel %d punches to %s",
+        BCD(type).ToAscii(),ch+1,AnsiString(path).c_str());
+    return(true);
+}
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------
+#ifndef UIDEVMAPH
+#define UIDEVMAPH
+//---------------------------------------------------------------------------
+
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//  Device map.  First of all, it says how many I/O channels the machine
+//  has: a 1410 has 2, a 7010 could have up to MAXCHANNEL.
+//
+//      CHANNELS n                      2 if not given
+//
+//  Channels 3 and 4 are addressed with the 1 bit added to the 8-4 of the
+//  channel / overlap character (so the B bit still picks the odd or the
+//  even one).  They have no lights on the panels.  B and Y test them with
+//  a d character of 3 or 4.  R and X always test channels 1 and 2, just
+//  as on a 1410 with 2 channels.  Carriage control (F) and
+//  select stacker (K) have only a channel 1 and a channel 2 form, with
+//  no channel character, so they can't reach channel 3 or 4 (see
+//  InstructionCarriageControl and InstructionSelectStacker).
+//
+//  The 1403 printer, 1402 reader and 1402 punch on the panels are always
+//  there, on channel 1.  The device map can attach more of them, on any
+//  channel.  Each one answers to a unit type of its own (the character
+//  after the % or the lozenge in the I/O address - the 2 in %20 for the
+//  printer on the panel), and has its own files:
+//
+//      PRINTER channel type path       Prints to capture file path
+//      READER  channel type path       Reads deck path
+//      PUNCH   channel type path       Punches to path (stackers 4 and 8
+//                                      go to path.4 and path.8)
+//
+//  The carriage control instruction (F) has no unit type in it, so it
+//  goes to whichever printer on its channel printed last (the one on the
+//  panel, after a reset).  F only has channel 1 and channel 2 forms, so a
+//  PRINTER line for channel 3 or 4 is rejected: nothing could ever skip
+//  or eject on it.
+//
+//  Blank lines and lines starting with * or ; are ignored, just like the
+//  tape library.  Devices from the map are not on any panel, so they run
+//  unattended: the printer starts out ready, the reader starts with its
+//  whole deck in the hopper and the EOF switch on, and the punch never
+//  runs out of cards.
+//
+//  The map is read from DEVMAP_FILE in the directory the simulator was
+//  started from, when the CPU is built: once for the channel count, before
+//  the channels are built, and again for the devices.  (Channels and
+//  devices can't be taken away once they are there.)
+
+#define DEVMAP_FILE         "IBM1410.dev"
+#define DEVMAP_HOPPERS      5                   //  Same as the channel
+
+class TDeviceMap {
+
+private:
+
+    static bool CanOpen(String path, bool output);
+    static bool Attach(String kind, int ch, int type, String path);
+
+public:
+
+    static int ChannelCount(String filename);   //  CHANNELS, or the default
+    static bool Load(String filename);          //  Read map, attach devices
+};
+
+#endif
@@ -1,128 +1,214 @@
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-//---------------------------------------------------------------------------
-#include <vcl.h>
-#pragma hdrstop
-
-#include <dir.h>
-#include <stdio.h>
-#include "ubcd.h"
-#include "UI1410CPUT.h"
-#include "UIHOPPER.h"
-#include "UI1410CHANNEL.h"
-#include "UIREADER.h"
-#include "UIHOPPER.h"
-
-//---------------------------------------------------------------------------
-#pragma package(smart_init)
-
-#include "UIPUNCH.h"
-#include "UI1402.h"
-#include "UI1410DEBUG.h"
-
-//  TCard Class Implementation
-
-TCard::TCard() {
-    Hopper = NULL;
-}
-
-bool TCard::Stack() {
-
-    return(Hopper -> Stack(this));
-}
-
-void TCard::SelectStacker(THopper *h) {
-    Hopper = h;
-}
-
-//  THopper Implementation
-
-//  Constructor
-
-THopper::THopper() {
-
-    Count = 0;
-    fd = NULL;
-	Filename = L"";
-}
-
-//  Method to stack a card
-
-bool THopper::Stack(TCard *card) {
-
-    char *cp;
-    char temp[83];
-
-    incCount();
-    if(fd == NULL) {
-        FI1402 -> Display();
-        return(true);
-    }
-    memcpy(temp,card->image,80);
-
-    //  Remove trailing blanks, and stick on CRLF
-
-    for(cp = temp+79; cp >= temp && *cp == ' '; --cp) {
-    }
-    *++cp = '\r';
-    *++cp = '\n';
-    *++cp = '\0';
-
-    try {
-        fd -> WriteBuffer(temp,strlen(temp));
-    }
-    catch(EWriteError &e) {
-        delete fd;
-        fd = NULL;
-        resetCount();
-        DEBUG("THopper::Stack Write Error. Closing file.");
-        return(false);
-    }
-
-    FI1402 -> Display();
-    return(true);
-}
-
-//  Method to associate (and open) a file with a hopper...
-
-bool THopper::setFilename(String s) {
-
-	resetCount();
-	if(fd != NULL) {
-		delete fd;
-		fd = NULL;
-	}
-	if(s.Length() == 0) {
-		return(false);
-	}
-
-	try {
-		fd = new TFileStream(s,fmCreate | fmShareDenyWrite);
-	}
-    catch(EFOpenError &e) {
-        return(false);
-    }
-
-	Filename = s;
-    return(true);
-}
-
-
-
-
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <dir.h>
+#include <stdio.h>
+#include <string.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UIHOPPER.h"
+#include "UI1410CHANNEL.h"
+#include "UIREADER.h"
+#include "UIHOPPER.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UIPUNCH.h"
+#include "UI1402.h"
+#include "UI1410DEBUG.h"
+
+//  TCard Class Implementation
+
+TCard::TCard() {
+    Hopper = NULL;
+}
+
+bool TCard::Stack() {
+
+    return(Hopper -> Stack(this));
+}
+
+void TCard::SelectStacker(THopper *h) {
+    Hopper = h;
+}
+
+//  The card pool.  Allocate hands out a card from the pool (or a new one,
+//  if the pool is empty), and Release puts one back.
+
+TCard *TCard::FreeCards = NULL;
+
+TCard *TCard::Allocate() {
+
+    TCard *card;
+
+    if(FreeCards == NULL) {
+        return(new TCard());
+    }
+    card = FreeCards;
+    FreeCards = card -> NextFree;
+    card -> Hopper = NULL;
+    return(card);
+}
+
+void TCard::Release() {
+    NextFree = FreeCards;
+    FreeCards = this;
+}
+
+//  THopper Implementation
+
+THopper *THopper::FirstHopper = NULL;
+DWORD THopper::DisplayTicks = 0;
+bool THopper::CapacityLimits = false;
+
+//  Constructor
+
+THopper::THopper() {
+
+    Count = 0;
+    InStacker = 0;
+    fd = NULL;
+	Filename = L"";
+
+    Buffer = new char[HOPPER_BUFFER_SIZE];
+    BufferLength = 0;
+    FlushTicks = GetTickCount();
+
+    NextHopper = FirstHopper;
+    FirstHopper = this;
+}
+
+//  Method to stack a card
+
+bool THopper::Stack(TCard *card) {
+
+    char *cp, *temp;
+    bool ok = true;
+
+    incCount();
+    ++InStacker;
+
+    if(fd != NULL) {
+
+        //  Make sure there is room for a whole card, plus CRLF and NUL
+
+        if(BufferLength + 83 > HOPPER_BUFFER_SIZE && !Flush()) {
+            return(false);
+        }
+        temp = Buffer + BufferLength;
+        memcpy(temp,card->image,80);
+
+        //  Remove trailing blanks, and stick on CRLF
+
+        for(cp = temp+79; cp >= temp && *cp == ' '; --cp) {
+        }
+        *++cp = '\r';
+        *++cp = '\n';
+        *++cp = '\0';
+
+        //  This used to go out with strlen(), so a NUL in the image (which
+        //  should not happen) still ends the card right there.
+
+        BufferLength += strlen(temp);
+
+        if(GetTickCount() - FlushTicks >= HOPPER_FLUSH_MS) {
+            ok = Flush();
+        }
+    }
+
+    if(GetTickCount() - DisplayTicks >= HOPPER_DISPLAY_MS) {
+        DisplayTicks = GetTickCount();
+        FI1402 -> Display();
+    }
+    return(ok);
+}
+
+//  Method to write out whatever cards are in the buffer.  A write error
+//  closes the file, just as it always has.
+
+bool THopper::Flush() {
+
+    FlushTicks = GetTickCount();
+    if(BufferLength == 0 || fd == NULL) {
+        BufferLength = 0;
+        return(true);
+    }
+
+    try {
+        fd -> WriteBuffer(Buffer,BufferLength);
+    }
+    catch(EWriteError &e) {
+        delete fd;
+        fd = NULL;
+        BufferLength = 0;
+        resetCount();
+        DEBUG("THopper::Stack Write Error. Closing file.");
+        return(false);
+    }
+
+    BufferLength = 0;
+    return(true);
+}
+
+//  Flush all of the hoppers, and bring the panel count up to date.  Called
+//  at the end of a job (and on the way out).
+
+void THopper::FlushAll() {
+
+    THopper *h;
+
+    for(h = FirstHopper; h != NULL; h = h -> NextHopper) {
+        h -> Flush();
+    }
+    DisplayTicks = GetTickCount();
+    FI1402 -> Display();
+}
+
+//  Method to associate (and open) a file with a hopper...
+
+bool THopper::setFilename(String s) {
+
+	Flush();
+	resetCount();
+	if(fd != NULL) {
+		delete fd;
+		fd = NULL;
+	}
+	if(s.Length() == 0) {
+		return(false);
+	}
+
+	try {
+		fd = new TFileStream(s,fmCreate | fmShareDenyWrite);
+	}
+    catch(EFOpenError &e) {
+        return(false);
+    }
+
+	Filename = s;
+    return(true);
+}
+
+
+
+
@@ -1,73 +1,130 @@
-//---------------------------------------------------------------------------
-#ifndef UIHOPPERH
-#define UIHOPPERH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-#define HOPPER_R0   0
-#define HOPPER_R1   1
-#define HOPPER_R2   2
-#define HOPPER_P8   2
-#define HOPPER_P4   3
-#define HOPPER_P0   4
-
-class THopper;                                      //  Forward declearation.
-
-//  Very simple class (almost a "struct") to represent a card image
-
-class TCard : public TObject {
-
-private:
-
-    THopper *Hopper;
-
-public:
-
-    TCard();                                    //  Constructor
-    unsigned char image[80];                    //  80 columns of data
-    void SelectStacker(THopper *h);             //  Select Stacker
-    bool Stack();                               //  Stack card to hopper
-};
-
-//  Class to represent a card Hopper on a Reader/Punch
-
-class THopper: public TObject {
-
-private:
-
-    int Count;                                          //  Count of cards
-    String Filename;                                    //  Corresponding file
-    TFileStream *fd;                                    //  File to write to
-
-public:
-
-    THopper();                                          //  Constructor
-
-    inline void resetCount() { Count = 0; }
-    inline void incCount() { ++Count; }
-    inline int getCount() { return Count; }
-
-	bool setFilename(String s);
-	String getFilename() { return Filename; }
-
-    bool Stack(TCard *card);
-};
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UIHOPPERH
+#define UIHOPPERH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define HOPPER_R0   0
+#define HOPPER_R1   1
+#define HOPPER_R2   2
+#define HOPPER_P8   2
+#define HOPPER_P4   3
+#define HOPPER_P0   4
+
+class THopper;                                      //  Forward declearation.
+
+//  Very simple class (almost a "struct") to represent a card image.
+//  Cards that are done with go back into a pool, rather than being
+//  deleted, so that reading a big deck doesn't allocate a card per card.
+
+class TCard : public TObject {
+
+private:
+
+    THopper *Hopper;
+    TCard *NextFree;                            //  Pool of free cards
+
+    static TCard *FreeCards;
+
+public:
+
+    TCard();                                    //  Constructor
+    unsigned char image[80];                    //  80 columns of data
+    unsigned char code[80];                     //  Same as BCD (reader only)
+    void SelectStacker(THopper *h);             //  Select Stacker
+    bool Stack();                               //  Stack card to hopper
+    inline THopper *GetHopper() { return Hopper; }
+
+    static TCard *Allocate();                   //  Get a card from the pool
+    void Release();                             //  Put it back
+};
+
+//  Class to represent a card Hopper on a Reader/Punch
+
+//  Cards stacked into a hopper with a file are collected in a buffer, which
+//  is written out when it fills, when a card is stacked and the buffer has
+//  been sitting for more than HOPPER_FLUSH_MS, or at the end of a job.
+//  The 1402 panel count is only updated every HOPPER_DISPLAY_MS, too.
+
+#define HOPPER_BUFFER_SIZE  65536
+#define HOPPER_FLUSH_MS     1000
+#define HOPPER_DISPLAY_MS   100
+
+//  A 1402 stacker holds about 1000 cards.  When one fills up, the reader
+//  or punch feeding it stops (and the STACKER light comes on) until the
+//  operator empties it and presses START.  The file keeps going, of course.
+//  That (and the feed hopper limits for the reader and punch) only happens
+//  if the CARD CAPACITY switch on the CE panel is on.  It is off to start,
+//  so nothing stops a long run that nobody is watching.
+
+#define HOPPER_CAPACITY     1000
+
+//  Reader and punch throughput, for the job report
+
+struct TCardStats {
+    long Cards;                                         //  Cards moved
+    long StackerFullStops;                              //  Stopped: full
+    long HopperEmptyStops;                              //  Stopped: empty
+    __int64 BusyCycles;                                 //  Card cycles
+    __int64 LastStop;                                   //  Virtual time
+};
+
+class THopper: public TObject {
+
+private:
+
+    int Count;                                          //  Count of cards
+    int InStacker;                                      //  Since emptied
+    String Filename;                                    //  Corresponding file
+    TFileStream *fd;                                    //  File to write to
+
+    char *Buffer;                                       //  Cards not written
+    long BufferLength;
+    DWORD FlushTicks;                                   //  When last written
+
+    THopper *NextHopper;                                //  List of hoppers
+    static THopper *FirstHopper;
+    static DWORD DisplayTicks;                          //  Last panel update
+
+public:
+
+    THopper();                                          //  Constructor
+
+    inline void resetCount() { Count = 0; }
+    inline void incCount() { ++Count; }
+    inline int getCount() { return Count; }
+
+	bool setFilename(String s);
+	String getFilename() { return Filename; }
+
+    bool Stack(TCard *card);
+    bool Flush();                                       //  Write the buffer
+
+    inline bool IsFull() {
+        return CapacityLimits && InStacker >= HOPPER_CAPACITY;
+    }
+    inline void Empty() { InStacker = 0; }
+
+    static void FlushAll();                             //  End of job
+
+    static bool CapacityLimits;                         //  CARD CAPACITY
+};
+
+#endif
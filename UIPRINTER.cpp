@@ -1,634 +1,775 @@
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-//---------------------------------------------------------------------------
-#include <vcl.h>
-#pragma hdrstop
-
-#include <dir.h>
-#include <assert.h>
-#include <stdlib.h>
-#include <stdio.h>
-#include <ctype.h>
-#include "ubcd.h"
-#include "UI1410CPUT.h"
-#include "UIHOPPER.h"
-#include "UI1410CHANNEL.h"
-#include "UI1410INST.h"
-#include "UIPRINTER.h"
-
-//---------------------------------------------------------------------------
-#pragma package(smart_init)
-
-#include "UI1403.h"
-#include "UI1410DEBUG.h"
-
-//  Printer Adapter Unit Implementation.  Follows I/O Device Interface.
-
-//  Constructor.  Creates a printer!  (NOTE:  RIGHT NOW, CAN ONLY BE 1 !!)
-
-T1403Printer::T1403Printer(int devicenum, T1410Channel *Channel) :
-    T1410IODevice(devicenum,Channel) {
-
-    BusyEntry = new TBusyDevice();
-
-    ccfd = NULL;
-    ccline[0] = '\0';
-    SetCarriageDefault();                       //  Default CC tape
-
-	// FileName[0] = '\0';
-    FileName = L"";
-    fd = NULL;
-
-    SkipLines = SkipChannel = 0;
-    CarriageAdvance = false;
-    BufferPosition = 0;
-
-    PrintStatus = 0;
-    Start();
-}
-
-//  Start.  Called from initialization and when Start button on printer
-//  user interface is pressed.
-
-void T1403Printer::Start() {
-	if(CarriageCheck) {
-		return;
-	}
-	Ready = true;
-	FI1403 -> LightPrintReady -> Enabled = true;
-}
-
-//  Stop.  Called when Stop button on printer user interface is pressed.
-
-void T1403Printer::Stop() {
-	Ready = false;
-	FI1403 -> LightPrintReady -> Enabled = false;
-}
-
-//  CheckReset: You guessed it: Called when the Check Reset button on the
-//  printer user interface is pressed.
-
-void T1403Printer::CheckReset() {
-	CarriageCheck = false;
-}
-
-//  Carriage Restore:  You know the routine.
-
-bool T1403Printer::CarriageRestore() {
-	return(CarriageSkip(0,1));
-}
-
-//  Carriage Space.  This one does a little more, because it is also
-//  called during Carriage Skip operations.
-
-bool T1403Printer::CarriageSpace() {
-
-	bool status;
-
-	CarriageAdvance = false;
-	status = FI1403 -> NextLine();
-	if(!status) {
-		PrintStatus |= IOCHCONDITION;
-	}
-
-	if(fd != NULL) {
-		if(!FileCapturePrint('\r') || !FileCapturePrint('\n')) {
-			PrintStatus |= IOCHCONDITION;
-			status = false;
-		}
-	}
-
-	if(++FormLine > FormLength) {
-		FormLine = 1;
-	}
-	return(status);
-}
-
-//  Carriage Stop
-
-void T1403Printer::CarriageStop() {
-	Stop();
-	CarriageCheck = true;
-	FI1403 -> LightFormsCheck -> Enabled = true;
-}
-
-//  Method to assign a name to the capture file
-
-bool T1403Printer::FileCaptureSet(String filename) {
-	if(filename.Length() >= MAXPATH) {
-		return(false);
-	}
-	// strcpy(FileName,filename);
-	FileName = filename;
-	return(true);
-}
-
-//  And, finally, open the capture file...
-
-bool T1403Printer::FileCaptureOpen() {
-	if(FileName.Length() == 0) {
-		return(false);
-	}
-	fd = new TFileStream(FileName,fmCreate | fmOpenWrite | fmShareDenyWrite);
-	return(fd != NULL);
-}
-
-
-//  Method to close down the capture file.
-
-void T1403Printer::FileCaptureClose() {
-	if(fd != NULL) {
-		delete fd;
-		fd = NULL;
-	}
-}
-
-//  Now, for the I/O Device Interface.
-
-//  Select is called at the beginning of an IO operation.
-
-int T1403Printer::Select() {
-
-	if(!Ready) {
-		return(IOCHNOTREADY);
-	}
-	if(BusyEntry -> TestBusy()) {
-		return(IOCHBUSY);
-	}
-	BufferPosition = 0;
-	if(Channel -> ChRead -> State() ||
-	   (Channel -> GetUnitNumber() != 0 && Channel -> GetUnitNumber() != 1) ) {
-		return(IOCHNOTREADY);
-	}
-	return(PrintStatus = 0);
-}
-
-//  Status Sample is called at the end of an I/O operation.
-
-int T1403Printer::StatusSample() {
-	if(Channel -> ChWrite -> State() && BufferPosition != PRINTPOSITIONS) {
-		PrintStatus |= IOCHWLRECORD;
-	}
-	return(Channel -> GetStatus() | PrintStatus);
-}
-
-//  Here is where the real work gets done...
-
-void T1403Printer::DoOutput() {
-
-	BCD ch_char;
-
-	//  If not ready, say so.
-
-	if(!Ready) {
-		PrintStatus |= IOCHNOTREADY;
-		Channel -> ExtEndofTransfer = true;
-		return;
-	}
-
-	//  If we have not advanced carriage since last print, do so now.
-	//  (The real 1410 would do this at the end of the transfer, but
-	//  that would require more buffer coordination in the simulator --
-	//  a real printer would have already printed the data)
-
-	if(CarriageAdvance) {
-		CarriageSpace();
-	}
-
-	//  Get character from the channel silo
-
-	ch_char = Channel -> ChR2 -> Get();
-
-	//  If we have too many characters, indicate the problem
-
-	if(BufferPosition >= PRINTPOSITIONS) {
-		PrintStatus |= IOCHWLRECORD;
-		Channel -> ExtEndofTransfer = true;
-		return;
-	}
-
-	//  Check the parity of the character coming from memory
-
-	if(!ch_char.CheckParity()) {
-		PrintStatus |= IOCHDATACHECK;
-	}
-
-	//  In Load Mode, we turn Wordmarks into Word Separators.
-	//  The addition of the word separator makes a Wrong Length Record very
-	//  very likely!
-
-	if(Channel -> LoadMode && ch_char.TestWM()) {
-		DoOutputChar(BCD_WS);
-		if(++BufferPosition >= PRINTPOSITIONS) {
-			PrintStatus |= IOCHWLRECORD;
-			Channel -> ExtEndofTransfer = true;
-			return;
-		}
-	}
-
-	//  Having handled Load Mode, we proceed.  For the normal print unit (%20),
-	//  we now print the character.  If we are in Move Mode and have the
-	//  alternate print unit (%21), we print a space, because we have already
-	//  stripped the WM.  (Not sure this is how it really worked, but the
-	//  Principles of Operation indicates that a L%21 prints a blank line).
-
-	if(Channel -> GetUnitNumber() == 0) {
-		DoOutputChar(ch_char);
-	}
-	else {  // %21
-		DoOutputChar(Channel -> MoveMode && ch_char.TestWM() ?
-			BCD_1 : BCD_SPACE);
-	}
-	++BufferPosition;
-
-	//  Check for end of transfer.  If we have need more characters,
-	//  let the Channel know.  Otherwise, let the Channel know we have
-	//  had enough.
-
-	//  Also, this is normally how we will know we are ready to print the
-    //  line.  (A Wrong Length Record can suppress output, according to the
-    //  Principles of Operation).  It is easier to do it here than wait to
-    //  do it a StatusSample time - which has to service both Print and
-    //  Carriage Control operations.  After we print the line, we might
-    //  also have a deferred Carriage Control operation to do.
-
-    if(BufferPosition == PRINTPOSITIONS) {
-        EndofLine();
-        if(SkipLines || SkipChannel) {
-            CarriageSkip(SkipLines, SkipChannel);
-            SkipLines = SkipChannel = 0;
-        }
-        else {
-            CarriageAdvance = true;                 //  No space -- yet
-        }
-        BusyEntry -> SetBusy(2);
-    }
-
-    //  Minor kludge.  We ask for another character, even if we just
-    //  printed.  If there is one, then we will detect WLR.
-
-    Channel -> OutputRequest = true;
-    Channel -> CycleRequired = true;
-}
-
-//  Send the output character to the appropriate device.
-
-void T1403Printer::DoOutputChar(BCD c) {
-
-	c = c & (BIT_NUM | BIT_ZONE);
-	if(!FI1403 -> SendBCD(c)) {
-		PrintStatus |= IOCHCONDITION;
-	}
-	if(fd != NULL) {
-		if(!FileCapturePrint(c.ToAscii())) {
-			PrintStatus |= IOCHCONDITION;
-		}
-	}
-}
-
-//  Send the word to the appropriate device that the line is complete.
-
-void T1403Printer::EndofLine() {
-
-	if(!FI1403 -> EndofLine()) {
-		PrintStatus |= IOCHCONDITION;
-	}
-
-	if(fd != NULL && !FileCapturePrint('\r')) {
-		PrintStatus |= IOCHCONDITION;
-	}
-
-}
-
-bool T1403Printer::FileCapturePrint(char c) {
-
-	if(fd == NULL) {
-		return(false);
-	}
-	if(fd -> Write(&c,1) != 1) {
-		DEBUG("T1403Printer::FileCapturePrint Error");
-		return(false);
-	}
-	return(true);
-}
-
-//  Carriage Control operations.  Basically pretty simple stuff.
-
-void T1403Printer::DoUnitControl(BCD opmod) {
-
-	Channel -> UnitControlOverlapBusy = NULL;
-	if(!Ready) {
-		PrintStatus |= IOCHNOTREADY;
-	}
-	else {
-		ControlCarriage(opmod);
-		BusyEntry -> SetBusy(2);
-	}
-	Channel -> ExtEndofTransfer = true;
-}
-
-void T1403Printer::ControlCarriage(BCD opmod) {
-
-	int dint;
-	int num;
-
-	dint = opmod.To6Bit();
-	num = dint & BIT_NUM;
-
-	//  A '-' suppresses the automatic space operation.
-
-	if(dint == OP_MOD_SYMBOL_MINUS) {
-		CarriageAdvance = false;
-	}
-
-	//  Single spaces get handled by default (may change later)
-
-	if(num == 0) {
-		return;
-	}
-
-	SkipChannel = SkipLines = 0;
-
-	//  0 - 9, #, @: Skip to carriage tape channels 1 - 12
-
-	if((dint & BIT_ZONE) == 0) {
-		if(num > 12) {
-			return;
-		}
-		CarriageSkip(0,num);
-	}
-
-	//  A -I, ? . <lozenge>:  Skip to channels 1-2 *after* printing
-
-	else if((dint & BIT_ZONE) == BIT_ZONE) {
-		if(num <= 12) {
-			SkipChannel = num;
-		}
-	}
-
-	//  J, K, L: Immediate space of 1, 2 or 3 lines
-
-	else if((dint & BIT_ZONE) == BITB) {
-		if(num > 3) {
-			return;
-		}
-		CarriageSkip(num,0);
-	}
-
-	//  /, S, T: Skip 1, 2 or 3 lines *after* printing
-
-	else {
-		if(num > 3) {
-			return;
-		}
-		SkipLines = num;
-	}
-}
-
-//  Printers ignore input.  (Actually, this should never get called, because
-//  select will return Not Ready on an attempt to select for input).
-
-void T1403Printer::DoInput() {
-	PrintStatus |= IOCHNOTREADY;
-	return;
-}
-
-//  PRIVATE routine to skip carriage to given channel or given number of lines.
-
-bool T1403Printer::CarriageSkip(int spaces, int chan) {
-
-	int line;
-
-	if(spaces < 0 || spaces > 4 || chan < 0 || chan > 12) {
-		CarriageStop();
-		return(false);
-	}
-
-	if(spaces > 0 && spaces < 4) {
-		while(spaces--) {
-			CarriageSpace();
-		}
-		return(true);
-	}
-
-	if(chan == 0) {
-		return(true);
-	}
-
-	for(line=0; line <= FormLength; ++line) {
-		CarriageSpace();
-		if(CarriageChannelTest(chan)) {
-			return(true);
-		}
-	}
-
-	CarriageStop();
-	return(false);
-}
-
-bool T1403Printer::CarriageChannelTest(int ch) {
-	return((CarriageTape[FormLine] & (1 << (ch-1))) != 0);
-}
-
-//  The rmaining code has to do with setting up the carriage control tape.
-//  A carriage control tape is read in from a file using the same format
-//  as the Newcomer 1401 simulator.
-
-//  * beginning a line indicates a comment
-//  LENGTH ###
-//  CHAN # = # [[+]#] ...
-
-//  Method to set up a default carriage tape, during construction
-
-void T1403Printer::SetCarriageDefault() {
-
-	int line;
-
-	for(line=0; line < PRINTMAXFORM; ++line) {
-		CarriageTape[line] = 0;
-	}
-
-	FormLength = 66;
-	FormLine = 1;
-	CarriageTape[4] = 1 | 2 | 4 | 8 | 16 | 32 | 64 | 128 | 512 | 1024;
-	//  Channesl      1   2   3   4    5    6    7    8     10     11
-
-	CarriageTape[61] = 256;     //  Channel 9
-	CarriageTape[63] = 2048;    //  Channel 12
-}
-
-//  Main method for carriage tape - sets up carriage tape from a file
-//  Returns 0 if tape is OK.  Returns - value if an error.  The value
-//  is in fact the line number.
-
-int T1403Printer::SetCarriageTape(String filename) {
-
-	char *elements[PRINTMAXTOKENS];               //  Up to 80 fields per line.
-	int line, chan, i, n;
-
-	for(line=0; line < PRINTMAXFORM; ++line) {
-		CarriageTape[line] = 0;
-	}
-
-	//  Passing us no file is OK: Means they want the default carriage tape.
-
-	if(filename == NULL || filename.Length() == 0) {
-		SetCarriageDefault();
-		return(0);
-	}
-
-	assert(ccfd == NULL);
-	line = 0;
-
-	//  Try and open the file.  If it fails, report an error on line 1.
-
-	try {
-		ccfd = new TFileStream(filename,fmOpenRead);
-	}
-	catch(EFOpenError &e) {
-        return(CarriageTapeError(-1));
-    }
-
-    //  Skip any leading comment lines.  Error if we hit EOF.
-
-    do {
-        if(!GetCarriageLine()) {
-            return(CarriageTapeError(-line));
-        }
-        ++line;
-    } while(ccline[0] == '*');
-
-    //  Parse the line.  It should have 2 elements.  LENGTH and the number
-
-    ParseCarriageLine(ccline,elements);
-    if(strcmp(elements[0],"LENGTH") != 0) {
-        return(CarriageTapeError(-line));
-    }
-    FormLength = atoi(elements[1]);
-    if(FormLength < 1 || FormLength > PRINTMAXFORM) {
-        return(CarriageTapeError(-line));
-    }
-
-    //  Now process the carriage control lines themselves.
-
-    n = 0;
-    while(GetCarriageLine()) {
-        ++line;
-        if(ccline[0] == '*') {                      //  * for comment
-            continue;
-        }
-        ParseCarriageLine(ccline,elements);
-        if(strcmp(elements[0],"CHAN") != 0 ||       //  Check CHAN # =
-           strcmp(elements[2],"=") != 0) {
-           return(CarriageTapeError(-line));
-        }
-        chan = atoi(elements[1]);
-        if(chan < 1 || chan > 12) {                 //  Validate channel number
-            return(CarriageTapeError(-line));
-        }
-        n = 0;
-        for(i=3; elements[i] != NULL; ++i) {        //  Process the form lines
-            if(*elements[i] == '+') {
-                n += atoi(elements[i]+1);
-            }
-            else {
-                n = atoi(elements[i]);
-            }
-            if(n < 1 || n > FormLength) {
-                CarriageTapeError(-line);
-            }
-            CarriageTape[n] |= (1 << (chan - 1));
-        }
-    }
-
-    FormLine = 1;
-    delete ccfd;
-    ccfd = NULL;
-    return(0);
-}
-
-//  Utility method to clean up after carriage tape errors
-
-int T1403Printer::CarriageTapeError(int rc) {
-
-    if(ccfd != NULL) {
-        delete ccfd;
-    }
-    ccfd = NULL;
-    SetCarriageDefault();
-    return(rc);
-}
-
-//  Method to get one line of input.  (Why Borland didn't have this kind of
-//  method as part of their file stream object I have *no* idea!
-
-bool T1403Printer::GetCarriageLine() {
-
-	char *cp;
-
-    if(ccfd == NULL) {
-        return(false);
-    }
-
-    for(cp = ccline; cp - ccline < PRINTCCMAXLINE; ++cp) {
-        if(ccfd -> Read(cp,1) != 1) {
-            return(false);
-        }
-        if(*cp == '\n') {
-            *cp = 0;
-            return(true);
-        }
-    }
-
-    ccline[PRINTCCMAXLINE-1] = 0;
-    return(false);
-}
-
-//  Method to set pointers to the tokens in a line.
-
-void T1403Printer::ParseCarriageLine(char *line, char **element) {
-
-    int i=0;
-    element[0] = NULL;
-
-    //  Ignore leading white space to find first token
-
-    while(*line && isspace(*line)) {
-        ++line;
-    }
-
-    //  Process tokens one at a time until end of line.
-
-    while(*line && i < PRINTMAXTOKENS-1) {
-        element[i] = line;
-        element[i+1] = NULL;
-        while(*++line && !isspace(*line)) {
-            //  Skip over rest of the token
-        }
-        if(!*line) {
-            break;
-        }
-        *line = 0;                              //  Terminate token with '\0'
-        while(*++line && isspace(*line)) {
-            //  Skip over white space
-        }
-        ++i;                                    //  Bump to next element
-    }
-}
-
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <dir.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UIHOPPER.h"
+#include "UI1410CHANNEL.h"
+#include "UI1410INST.h"
+#include "UIPRINTER.h"
+#include "UIPRINTSPOOL.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1403.h"
+#include "UI1410DEBUG.h"
+
+//  Printer Adapter Unit Implementation.  Follows I/O Device Interface.
+
+T1403Printer *T1403Printer::FirstPrinter = NULL;
+
+//  Constructor.  Creates a printer!  It starts out on the 1403 panel - the
+//  device map calls Unattended() for any others.
+
+T1403Printer::T1403Printer(int devicenum, T1410Channel *Channel) :
+    T1410IODevice(devicenum,Channel) {
+
+    BusyEntry = new TBusyDevice();
+    OnPanel = true;
+    CarriageCheck = false;
+    NextPrinter = FirstPrinter;
+    FirstPrinter = this;
+
+    ccfd = NULL;
+    ccline[0] = '\0';
+    SetCarriageDefault();                       //  Default CC tape
+
+	// FileName[0] = '\0';
+    FileName = L"";
+    spool = NULL;
+    CaptureLength = 0;
+
+    SkipLines = SkipChannel = 0;
+    CarriageAdvance = false;
+    CarriageLines = 0;
+    BufferPosition = 0;
+
+    PrintStatus = 0;
+    Start();
+}
+
+//  Start.  Called from initialization and when Start button on printer
+//  user interface is pressed.
+
+void T1403Printer::Start() {
+	if(CarriageCheck) {
+		return;
+	}
+	Ready = true;
+	if(OnPanel) {
+		FI1403 -> LightPrintReady -> Enabled = true;
+	}
+}
+
+//  Stop.  Called when Stop button on printer user interface is pressed.
+
+void T1403Printer::Stop() {
+	Ready = false;
+	if(OnPanel) {
+		FI1403 -> LightPrintReady -> Enabled = false;
+	}
+}
+
+//  CheckReset: You guessed it: Called when the Check Reset button on the
+//  printer user interface is pressed.
+
+void T1403Printer::CheckReset() {
+	CarriageCheck = false;
+}
+
+//  Carriage Restore:  You know the routine.
+
+bool T1403Printer::CarriageRestore() {
+	return(CarriageSkip(0,1));
+}
+
+//  Carriage Space.
+
+bool T1403Printer::CarriageSpace() {
+	return(CarriageMove(1));
+}
+
+//  PRIVATE routine to move the carriage some number of lines.  Spacing and
+//  skipping both come through here, and the whole move goes to the capture
+//  spool at once.
+
+bool T1403Printer::CarriageMove(int lines) {
+
+	bool status = true;
+	int i, line, top = -1;
+
+	CarriageAdvance = false;
+	for(i=0; i < lines; ++i) {
+		if(OnPanel && !FI1403 -> NextLine()) {
+			PrintStatus |= IOCHCONDITION;
+			status = false;
+		}
+	}
+
+	//  Note whether (and how long ago) the carriage passed channel 1, for
+	//  the page index and ASA carriage control.  Hop from one channel 1
+	//  punch to the next, rather than looking at every line.
+
+	line = FormLine;
+	for(i = CarriageStops[line][0]; i > 0 && i <= lines;
+		i += CarriageStops[line][0]) {
+		line = (FormLine - 1 + i) % FormLength + 1;
+		top = lines - i;
+	}
+	line = (FormLine - 1 + lines) % FormLength + 1;
+
+	if(spool != NULL) {
+		if(!FileCaptureLine(false) || !spool -> Space(lines,top)) {
+			PrintStatus |= IOCHCONDITION;
+			status = false;
+		}
+	}
+
+	FormLine = line;
+	CarriageLines += lines;
+	return(status);
+}
+
+//  Carriage Stop
+
+void T1403Printer::CarriageStop() {
+	Stop();
+	CarriageCheck = true;
+	if(OnPanel) {
+		FI1403 -> LightFormsCheck -> Enabled = true;
+	}
+}
+
+//  Method to assign a name to the capture file
+
+bool T1403Printer::FileCaptureSet(String filename) {
+	if(filename.Length() >= MAXPATH) {
+		return(false);
+	}
+	// strcpy(FileName,filename);
+	FileName = filename;
+	return(true);
+}
+
+//  And, finally, open the capture file...
+
+bool T1403Printer::FileCaptureOpen() {
+
+	TFileStream *fd;
+
+	if(FileName.Length() == 0) {
+		return(false);
+	}
+	FileCaptureClose();
+	try {
+		fd = new TFileStream(FileName,fmCreate | fmOpenWrite | fmShareDenyWrite);
+	}
+	catch(EFCreateError &e) {
+		return(false);
+	}
+	spool = new TPrintSpool(fd,FileName + ".idx",
+		SameText(ExtractFileExt(FileName),".asa"));
+	CaptureLength = 0;
+	return(true);
+}
+
+
+//  Method to close down the capture file.  Anything still in the spool
+//  gets written out first.
+
+void T1403Printer::FileCaptureClose() {
+	if(spool != NULL) {
+		FileCaptureLine(false);
+		delete spool;
+		spool = NULL;
+	}
+	CaptureLength = 0;
+}
+
+//  Method to write out whatever is in the spool (at the end of a job).
+
+void T1403Printer::FileCaptureFlush() {
+	if(spool != NULL && !spool -> Flush()) {
+		DEBUG("T1403Printer::FileCaptureFlush Error");
+	}
+}
+
+//  A printer that is not on the 1403 panel.  Nobody sees its lights or
+//  its paper: it just goes to its capture file.
+
+void T1403Printer::Unattended() {
+	OnPanel = false;
+}
+
+//  Write out the spools of all of the printers (at the end of a job), or
+//  close them all down (on the way out).
+
+void T1403Printer::FlushAll() {
+
+	T1403Printer *p;
+
+	for(p = FirstPrinter; p != NULL; p = p -> NextPrinter) {
+		p -> FileCaptureFlush();
+	}
+}
+
+void T1403Printer::CloseAll() {
+
+	T1403Printer *p;
+
+	for(p = FirstPrinter; p != NULL; p = p -> NextPrinter) {
+		p -> FileCaptureClose();
+	}
+}
+
+//  Now, for the I/O Device Interface.
+
+//  Select is called at the beginning of an IO operation.
+
+int T1403Printer::Select() {
+
+	if(!Ready) {
+		return(IOCHNOTREADY);
+	}
+	if(BusyEntry -> TestBusy()) {
+		return(IOCHBUSY);
+	}
+	BufferPosition = 0;
+	if(Channel -> ChRead -> State() ||
+	   (Channel -> GetUnitNumber() != 0 && Channel -> GetUnitNumber() != 1) ) {
+		return(IOCHNOTREADY);
+	}
+	Channel -> CarriageUnit = GetDeviceNumber();	//  Carriage control
+	return(PrintStatus = 0);
+}
+
+//  Status Sample is called at the end of an I/O operation.
+
+int T1403Printer::StatusSample() {
+	if(Channel -> ChWrite -> State() && BufferPosition != PRINTPOSITIONS) {
+		PrintStatus |= IOCHWLRECORD;
+	}
+	return(Channel -> GetStatus() | PrintStatus);
+}
+
+//  Here is where the real work gets done...
+
+void T1403Printer::DoOutput() {
+
+	BCD ch_char;
+
+	//  If not ready, say so.
+
+	if(!Ready) {
+		PrintStatus |= IOCHNOTREADY;
+		Channel -> ExtEndofTransfer = true;
+		return;
+	}
+
+	//  If we have not advanced carriage since last print, do so now.
+	//  (The real 1410 would do this at the end of the transfer, but
+	//  that would require more buffer coordination in the simulator --
+	//  a real printer would have already printed the data)
+
+	if(CarriageAdvance) {
+		CarriageSpace();
+	}
+
+	//  Get character from the channel silo
+
+	ch_char = Channel -> ChR2 -> Get();
+
+	//  If we have too many characters, indicate the problem
+
+	if(BufferPosition >= PRINTPOSITIONS) {
+		PrintStatus |= IOCHWLRECORD;
+		Channel -> ExtEndofTransfer = true;
+		return;
+	}
+
+	//  Check the parity of the character coming from memory
+
+	if(!ch_char.CheckParity()) {
+		PrintStatus |= IOCHDATACHECK;
+	}
+
+	//  In Load Mode, we turn Wordmarks into Word Separators.
+	//  The addition of the word separator makes a Wrong Length Record very
+	//  very likely!
+
+	if(Channel -> LoadMode && ch_char.TestWM()) {
+		DoOutputChar(BCD_WS);
+		if(++BufferPosition >= PRINTPOSITIONS) {
+			PrintStatus |= IOCHWLRECORD;
+			Channel -> ExtEndofTransfer = true;
+			return;
+		}
+	}
+
+	//  Having handled Load Mode, we proceed.  For the normal print unit (%20),
+	//  we now print the character.  If we are in Move Mode and have the
+	//  alternate print unit (%21), we print a space, because we have already
+	//  stripped the WM.  (Not sure this is how it really worked, but the
+	//  Principles of Operation indicates that a L%21 prints a blank line).
+
+	if(Channel -> GetUnitNumber() == 0) {
+		DoOutputChar(ch_char);
+	}
+	else {  // %21
+		DoOutputChar(Channel -> MoveMode && ch_char.TestWM() ?
+			BCD_1 : BCD_SPACE);
+	}
+	++BufferPosition;
+
+	//  Check for end of transfer.  If we have need more characters,
+	//  let the Channel know.  Otherwise, let the Channel know we have
+	//  had enough.
+
+	//  Also, this is normally how we will know we are ready to print the
+    //  line.  (A Wrong Length Record can suppress output, according to the
+    //  Principles of Operation).  It is easier to do it here than wait to
+    //  do it a StatusSample time - which has to service both Print and
+    //  Carriage Control operations.  After we print the line, we might
+    //  also have a deferred Carriage Control operation to do.
+
+    if(BufferPosition == PRINTPOSITIONS) {
+        EndofLine();
+        if(SkipLines || SkipChannel) {
+            CarriageSkip(SkipLines, SkipChannel);
+            SkipLines = SkipChannel = 0;
+        }
+        else {
+            CarriageAdvance = true;                 //  No space -- yet
+        }
+        CarriageBusy(PRINTER_LINE_US);
+    }
+
+    //  Minor kludge.  We ask for another character, even if we just
+    //  printed.  If there is one, then we will detect WLR.
+
+    Channel -> OutputRequest = true;
+    Channel -> CycleRequired = true;
+}
+
+//  Send the output character to the appropriate device.
+
+void T1403Printer::DoOutputChar(BCD c) {
+
+	c = c & (BIT_NUM | BIT_ZONE);
+	if(OnPanel && !FI1403 -> SendBCD(c)) {
+		PrintStatus |= IOCHCONDITION;
+	}
+	if(spool != NULL) {
+		if(CaptureLength >= PRINTCAPTURELINE && !FileCaptureLine(false)) {
+			PrintStatus |= IOCHCONDITION;
+		}
+		CaptureLine[CaptureLength++] = c.ToAscii();
+	}
+}
+
+//  Send the word to the appropriate device that the line is complete.
+
+void T1403Printer::EndofLine() {
+
+	if(OnPanel && !FI1403 -> EndofLine()) {
+		PrintStatus |= IOCHCONDITION;
+	}
+
+	if(spool != NULL && !FileCaptureLine(true)) {
+		PrintStatus |= IOCHCONDITION;
+	}
+
+}
+
+//  PRIVATE routine to send the line captured so far to the spool.  If end
+//  is false, this is just part of a line (a short line that never got a
+//  carriage return, or carriage motion after a wrong length record), so
+//  the file still comes out just as it did when it went a byte at a time.
+
+bool T1403Printer::FileCaptureLine(bool end) {
+
+	int length = CaptureLength;
+
+	CaptureLength = 0;
+	if(spool == NULL || (length == 0 && !end)) {
+		return(true);
+	}
+	if(!spool -> Print(CaptureLine,length,end)) {
+		DEBUG("T1403Printer::FileCaptureLine Error");
+		return(false);
+	}
+	return(true);
+}
+
+//  Carriage Control operations.  Basically pretty simple stuff.
+
+void T1403Printer::DoUnitControl(BCD opmod) {
+
+	Channel -> UnitControlOverlapBusy = NULL;
+	if(!Ready) {
+		PrintStatus |= IOCHNOTREADY;
+	}
+	else {
+		ControlCarriage(opmod);
+		CarriageBusy(PRINTER_SPACE_US);
+	}
+	Channel -> ExtEndofTransfer = true;
+}
+
+void T1403Printer::ControlCarriage(BCD opmod) {
+
+	int dint;
+	int num;
+
+	dint = opmod.To6Bit();
+	num = dint & BIT_NUM;
+
+	//  A '-' suppresses the automatic space operation.
+
+	if(dint == OP_MOD_SYMBOL_MINUS) {
+		CarriageAdvance = false;
+	}
+
+	//  Single spaces get handled by default (may change later)
+
+	if(num == 0) {
+		return;
+	}
+
+	SkipChannel = SkipLines = 0;
+
+	//  0 - 9, #, @: Skip to carriage tape channels 1 - 12
+
+	if((dint & BIT_ZONE) == 0) {
+		if(num > 12) {
+			return;
+		}
+		CarriageSkip(0,num);
+	}
+
+	//  A -I, ? . <lozenge>:  Skip to channels 1-2 *after* printing
+
+	else if((dint & BIT_ZONE) == BIT_ZONE) {
+		if(num <= 12) {
+			SkipChannel = num;
+		}
+	}
+
+	//  J, K, L: Immediate space of 1, 2 or 3 lines
+
+	else if((dint & BIT_ZONE) == BITB) {
+		if(num > 3) {
+			return;
+		}
+		CarriageSkip(num,0);
+	}
+
+	//  /, S, T: Skip 1, 2 or 3 lines *after* printing
+
+	else {
+		if(num > 3) {
+			return;
+		}
+		SkipLines = num;
+	}
+}
+
+//  Printers ignore input.  (Actually, this should never get called, because
+//  select will return Not Ready on an attempt to select for input).
+
+void T1403Printer::DoInput() {
+	PrintStatus |= IOCHNOTREADY;
+	return;
+}
+
+//  PRIVATE routine to skip carriage to given channel or given number of lines.
+
+bool T1403Printer::CarriageSkip(int spaces, int chan) {
+
+	int lines;
+
+	if(spaces < 0 || spaces > 4 || chan < 0 || chan > 12) {
+		CarriageStop();
+		return(false);
+	}
+
+	if(spaces > 0 && spaces < 4) {
+		CarriageMove(spaces);
+		return(true);
+	}
+
+	if(chan == 0) {
+		return(true);
+	}
+
+	//  Look up the next punch in the channel, then go there in one move.
+	//  If there isn't one, the carriage runs away for a whole form (and one
+	//  more line), and stops.
+
+	if((lines = CarriageStops[FormLine][chan-1]) > 0) {
+		CarriageMove(lines);
+		return(true);
+	}
+
+	CarriageMove(FormLength + 1);
+	CarriageStop();
+	return(false);
+}
+
+bool T1403Printer::CarriageChannelTest(int ch) {
+	return((CarriageTape[FormLine] & (1 << (ch-1))) != 0);
+}
+
+//  PRIVATE routine to go busy after a print or carriage operation.  The
+//  first line of carriage motion is included in "us".  Any more go at
+//  skip speed.
+
+void T1403Printer::CarriageBusy(long us) {
+
+	if(CarriageLines > 1) {
+		us += (CarriageLines - 1) * PRINTER_SKIP_US;
+	}
+	CarriageLines = 0;
+	BusyEntry -> SetBusyCycles(TVirtualClock::FromMicroseconds(us));
+}
+
+//  The rmaining code has to do with setting up the carriage control tape.
+//  A carriage control tape is read in from a file using the same format
+//  as the Newcomer 1401 simulator.
+
+//  * beginning a line indicates a comment
+//  LENGTH ###
+//  CHAN # = # [[+]#] ...
+
+//  Method to set up a default carriage tape, during construction
+
+void T1403Printer::SetCarriageDefault() {
+
+	int line;
+
+	for(line=0; line <= PRINTMAXFORM; ++line) {
+		CarriageTape[line] = 0;
+	}
+
+	FormLength = 66;
+	FormLine = 1;
+	CarriageTape[4] = 1 | 2 | 4 | 8 | 16 | 32 | 64 | 128 | 512 | 1024;
+	//  Channesl      1   2   3   4    5    6    7    8     10     11
+
+	CarriageTape[61] = 256;     //  Channel 9
+	CarriageTape[63] = 2048;    //  Channel 12
+
+	CompileCarriageTape();
+}
+
+//  PRIVATE routine to compile the carriage tape into CarriageStops.  For
+//  each channel, work backwards up the form, twice around (the first time
+//  through, we don't know yet what comes after the last line).  d is the
+//  distance from the line to the next punch after it.
+
+void T1403Printer::CompileCarriageTape() {
+
+	int chan, line, next, pass, d;
+
+	for(chan=0; chan < 12; ++chan) {
+		d = 0;
+		for(pass=0; pass < 2; ++pass) {
+			for(line=FormLength; line >= 1; --line) {
+				next = (line == FormLength) ? 1 : line + 1;
+				if(CarriageTape[next] & (1 << chan)) {
+					d = 1;
+				}
+				else if(d > 0) {
+					++d;
+				}
+				CarriageStops[line][chan] = (short) d;
+			}
+		}
+	}
+}
+
+//  Main method for carriage tape - sets up carriage tape from a file
+//  Returns 0 if tape is OK.  Returns - value if an error.  The value
+//  is in fact the line number.
+
+int T1403Printer::SetCarriageTape(String filename) {
+
+	char *elements[PRINTMAXTOKENS];               //  Up to 80 fields per line.
+	int line, chan, i, n;
+
+	for(line=0; line <= PRINTMAXFORM; ++line) {
+		CarriageTape[line] = 0;
+	}
+
+	//  Passing us no file is OK: Means they want the default carriage tape.
+
+	if(filename == NULL || filename.Length() == 0) {
+		SetCarriageDefault();
+		return(0);
+	}
+
+	assert(ccfd == NULL);
+	line = 0;
+
+	//  Try and open the file.  If it fails, report an error on line 1.
+
+	try {
+		ccfd = new TFileStream(filename,fmOpenRead);
+	}
+	catch(EFOpenError &e) {
+        return(CarriageTapeError(-1));
+    }
+
+    //  Skip any leading comment lines.  Error if we hit EOF.
+
+    do {
+        if(!GetCarriageLine()) {
+            return(CarriageTapeError(-line));
+        }
+        ++line;
+    } while(ccline[0] == '*');
+
+    //  Parse the line.  It should have 2 elements.  LENGTH and the number
+
+    ParseCarriageLine(ccline,elements);
+    if(strcmp(elements[0],"LENGTH") != 0) {
+        return(CarriageTapeError(-line));
+    }
+    FormLength = atoi(elements[1]);
+    if(FormLength < 1 || FormLength > PRINTMAXFORM) {
+        return(CarriageTapeError(-line));
+    }
+
+    //  Now process the carriage control lines themselves.
+
+    n = 0;
+    while(GetCarriageLine()) {
+        ++line;
+        if(ccline[0] == '*') {                      //  * for comment
+            continue;
+        }
+        ParseCarriageLine(ccline,elements);
+        if(strcmp(elements[0],"CHAN") != 0 ||       //  Check CHAN # =
+           strcmp(elements[2],"=") != 0) {
+           return(CarriageTapeError(-line));
+        }
+        chan = atoi(elements[1]);
+        if(chan < 1 || chan > 12) {                 //  Validate channel number
+            return(CarriageTapeError(-line));
+        }
+        n = 0;
+        for(i=3; elements[i] != NULL; ++i) {        //  Process the form lines
+            if(*elements[i] == '+') {
+                n += atoi(elements[i]+1);
+            }
+            else {
+                n = atoi(elements[i]);
+            }
+            if(n < 1 || n > FormLength) {
+                return(CarriageTapeError(-line));
+            }
+            CarriageTape[n] |= (1 << (chan - 1));
+        }
+    }
+
+    FormLine = 1;
+    delete ccfd;
+    ccfd = NULL;
+    CompileCarriageTape();
+    return(0);
+}
+
+//  Utility method to clean up after carriage tape errors
+
+int T1403Printer::CarriageTapeError(int rc) {
+
+    if(ccfd != NULL) {
+        delete ccfd;
+    }
+    ccfd = NULL;
+    SetCarriageDefault();
+    return(rc);
+}
+
+//  Method to get one line of input.  (Why Borland didn't have this kind of
+//  method as part of their file stream object I have *no* idea!
+
+bool T1403Printer::GetCarriageLine() {
+
+	char *cp;
+
+    if(ccfd == NULL) {
+        return(false);
+    }
+
+    for(cp = ccline; cp - ccline < PRINTCCMAXLINE; ++cp) {
+        if(ccfd -> Read(cp,1) != 1) {
+            return(false);
+        }
+        if(*cp == '\n') {
+            *cp = 0;
+            return(true);
+        }
+    }
+
+    ccline[PRINTCCMAXLINE-1] = 0;
+    return(false);
+}
+
+//  Method to set pointers to the tokens in a line.
+
+void T1403Printer::ParseCarriageLine(char *line, char **element) {
+
+    int i=0;
+    element[0] = NULL;
+
+    //  Ignore leading white space to find first token
+
+    while(*line && isspace(*line)) {
+        ++line;
+    }
+
+    //  Process tokens one at a time until end of line.
+
+    while(*line && i < PRINTMAXTOKENS-1) {
+        element[i] = line;
+        element[i+1] = NULL;
+        while(*++line && !isspace(*line)) {
+            //  Skip over rest of the token
+        }
+        if(!*line) {
+            break;
+        }
+        *line = 0;                              //  Terminate token with '\0'
+        while(*++line && isspace(*line)) {
+            //  Skip over white space
+        }
+        ++i;                                    //  Bump to next element
+    }
+}
+
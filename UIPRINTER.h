@@ -1,100 +1,140 @@
-//---------------------------------------------------------------------------
-#ifndef UIPRINTERH
-#define UIPRINTERH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-#define PRINTMAXFORM    1024
-#define PRINTMAXTOKENS  80
-#define PRINTCCMAXLINE  256
-
-#define PRINTER_IO_DEVICE   2
-
-//  Printer Adapter Unit (1414)
-
-class T1403Printer : public T1410IODevice {
-
-protected:
-
-	int PrintStatus;                            //  Printer Status for Channel
-	bool Ready;                                 //  True if ready to go
-	bool CarriageCheck;                         //  True if runaway forms
-	TBusyDevice *BusyEntry;                     //  Used to set delays
-	int BufferPosition;                         //  Current output column
-
-	int SkipLines;                              //  Deferred Skip in lines
-	int SkipChannel;                            //  Deferred Skip to Channel
-	bool CarriageAdvance;                       //  True to auto advance carriage
-
-	int FormLength;                             //  Length of current form
-	int FormLine;                               //  Current line in form
-
-	TFileStream *ccfd;                          //  Carriage Control File
-	int CarriageTape[PRINTMAXFORM];             //  Carriage tape data
-	char ccline[PRINTCCMAXLINE];
-
-	String FileName;		                    //  File name, if to file
-	TFileStream *fd;                            //  File FDs for print, CC file
-
-public:
-
-	T1403Printer(int devicenum, T1410Channel *Channel);
-
-	inline bool IsReady() { return(Ready); }
-	inline bool IsBusy() { return BusyEntry -> TestBusy(); }
-
-    void Start();                               //  Called from UI Start Button
-    void Stop();                                //  Called from UI Stop Button
-    void CheckReset();                          //  Called from UI Check Reset
-
-    bool CarriageRestore();                     //  Carriage to Channel 1
-    void CarriageStop();                        //  Called from UI Carriage Stop
-    bool CarriageSpace();                       //  Space to next line
-
-    virtual int Select();                       //  Channel Select
-    virtual void DoOutput();                    //  Character to output
-    virtual void DoInput();                     //  NOP on this device
-    virtual int StatusSample();                 //  End of I/O status sample
-    virtual void DoUnitControl(BCD opmod);      //  CC operation
-
-    void ControlCarriage(BCD opmod);
-
-	void DoOutputChar(BCD c);                   //  Send one char of output
-    void EndofLine();                           //  Flush line to device.
-
-	int SetCarriageTape(String tapefile);       //  Set up carriage control
-	void SetCarriageDefault();                  //  Set default CC tape
-	bool CarriageChannelTest(int cchannel);     //  True if this line has chan.
-
-	void FileCaptureClose();                    //  Terminate file capture
-	bool FileCaptureSet(String filename);       //  Set capture file name
-    bool FileCaptureOpen();                     //  Open capture filename
-    bool FileCapturePrint(char c);              //  Print a character to file
-
-private:
-
-    bool CarriageSkip(int lines, int channel);
-    bool GetCarriageLine();
-	void ParseCarriageLine(char *line, char **elements);
-    int CarriageTapeError(int rc);              //  Cleans up after tape errors
-
-};
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UIPRINTERH
+#define UIPRINTERH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define PRINTMAXFORM    1024
+#define PRINTMAXTOKENS  80
+#define PRINTCCMAXLINE  256
+#define PRINTCAPTURELINE 132                    //  Same as PRINTPOSITIONS
+
+#define PRINTER_IO_DEVICE   2
+
+//  1403 timing, in microseconds.  A model 2 prints 600 lines per minute,
+//  which includes a single space.  Each extra line of spacing or skipping
+//  goes at the skip speed (33 inches per second, 6 lines per inch).  A
+//  carriage operation by itself still has to start and stop the carriage.
+
+#define PRINTER_LINE_US     100000
+#define PRINTER_SPACE_US    20000
+#define PRINTER_SKIP_US     5000
+
+class TPrintSpool;                              //  Forward declaration
+
+//  Printer Adapter Unit (1414)
+
+//  There can be more than one printer: the one on the 1403 panel, plus any
+//  attached from the device map (see UIDEVMAP).  Those are not on a panel,
+//  so they always print to their capture file.  All of the printers are
+//  kept on a list, so that their spools can be written out at the end of
+//  a job.
+
+class T1403Printer : public T1410IODevice {
+
+protected:
+
+	int PrintStatus;                            //  Printer Status for Channel
+	bool Ready;                                 //  True if ready to go
+	bool CarriageCheck;                         //  True if runaway forms
+	TBusyDevice *BusyEntry;                     //  Used to set delays
+	int BufferPosition;                         //  Current output column
+
+	int SkipLines;                              //  Deferred Skip in lines
+	int SkipChannel;                            //  Deferred Skip to Channel
+	bool CarriageAdvance;                       //  True to auto advance carriage
+	int CarriageLines;                          //  Lines moved, for timing
+
+	int FormLength;                             //  Length of current form
+	int FormLine;                               //  Current line in form
+
+	TFileStream *ccfd;                          //  Carriage Control File
+	int CarriageTape[PRINTMAXFORM + 1];         //  Carriage tape data
+
+	//  The carriage tape, compiled: for each line and channel, how many
+	//  lines it is to the next punch in that channel (0 if there isn't
+	//  one anywhere on the tape).  Built whenever the tape changes.
+
+	short CarriageStops[PRINTMAXFORM + 1][12];
+	char ccline[PRINTCCMAXLINE];
+
+	String FileName;		                    //  File name, if to file
+	TPrintSpool *spool;                         //  Capture file spool
+	char CaptureLine[PRINTCAPTURELINE];         //  Line being captured
+	int CaptureLength;
+
+	bool OnPanel;                               //  False if no 1403 panel
+	T1403Printer *NextPrinter;                  //  List of printers
+	static T1403Printer *FirstPrinter;
+
+public:
+
+	T1403Printer(int devicenum, T1410Channel *Channel);
+
+	inline bool IsReady() { return(Ready); }
+	inline bool IsBusy() { return BusyEntry -> TestBusy(); }
+
+    void Start();                               //  Called from UI Start Button
+    void Stop();                                //  Called from UI Stop Button
+    void CheckReset();                          //  Called from UI Check Reset
+
+    bool CarriageRestore();                     //  Carriage to Channel 1
+    void CarriageStop();                        //  Called from UI Carriage Stop
+    bool CarriageSpace();                       //  Space to next line
+
+    virtual int Select();                       //  Channel Select
+    virtual void DoOutput();                    //  Character to output
+    virtual void DoInput();                     //  NOP on this device
+    virtual int StatusSample();                 //  End of I/O status sample
+    virtual void DoUnitControl(BCD opmod);      //  CC operation
+
+    void ControlCarriage(BCD opmod);
+
+	void DoOutputChar(BCD c);                   //  Send one char of output
+    void EndofLine();                           //  Flush line to device.
+
+	int SetCarriageTape(String tapefile);       //  Set up carriage control
+	void SetCarriageDefault();                  //  Set default CC tape
+	bool CarriageChannelTest(int cchannel);     //  True if this line has chan.
+
+	void FileCaptureClose();                    //  Terminate file capture
+	bool FileCaptureSet(String filename);       //  Set capture file name
+    bool FileCaptureOpen();                     //  Open capture filename
+    void FileCaptureFlush();                    //  Write out what is spooled
+
+    void Unattended();                          //  Not on the 1403 panel
+
+    static void FlushAll();                     //  End of job
+    static void CloseAll();                     //  Emergency off
+
+private:
+
+    bool CarriageSkip(int lines, int channel);
+    bool CarriageMove(int lines);               //  Space some lines
+    bool FileCaptureLine(bool end);             //  Spool the captured line
+    bool GetCarriageLine();
+	void ParseCarriageLine(char *line, char **elements);
+    int CarriageTapeError(int rc);              //  Cleans up after tape errors
+    void CompileCarriageTape();                 //  Build CarriageStops
+    void CarriageBusy(long us);                 //  Go busy for line + skip
+
+};
+
+#endif
@@ -0,0 +1,318 @@
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "UIPRINTSPOOL.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+
+//  Print Spool Implementation
+
+//  Constructor.  The spool takes over the (open) capture file.
+
+__fastcall TPrintSpool::TPrintSpool(TFileStream *f, String indexname,
+    bool asa) : TThread(true) {
+
+    fd = f;
+    IndexName = indexname;
+    ASA = asa;
+    Offset = 0;
+    TopOfForm = false;
+    Pending = 0;
+    Pages = NULL;
+    PageCount = PageCapacity = 0;
+
+    Wake = new TEvent(NULL,false,false,"",false);
+    Done = new TEvent(NULL,false,false,"",false);
+    Ring = new TPrintSpoolBuffer[PRINT_SPOOL_BUFFERS];
+    Head = Tail = 0;
+    Fill = &Ring[0];
+    Fill -> Length = 0;
+    Failed = false;
+    Lines = Writes = Waits = 0;
+    Start();
+}
+
+//  Destructor.  Writes out whatever is left, stops the thread, and closes
+//  the file.
+
+__fastcall TPrintSpool::~TPrintSpool() {
+
+    Flush();
+    Terminate();
+    Wake -> SetEvent();
+    WaitFor();
+
+    DEBUG("TPrintSpool: %ld lines, %ld pages, %ld writes, "
+        "printer waited %ld times",Lines,PageCount,Writes,Waits);
+
+    delete fd;
+    SaveIndex();
+    delete[] Pages;
+    delete Wake;
+    delete Done;
+    delete[] Ring;
+}
+
+//  The thread itself.  Writes buffers as the printer hands them over.
+//  After a write error, it just throws them away, so the printer never
+//  gets stuck waiting for room.
+
+void __fastcall TPrintSpool::Execute() {
+
+    TPrintSpoolBuffer *b;
+
+    while(true) {
+        if(Tail != Head) {
+            MemoryBarrier();
+            b = &Ring[Tail % PRINT_SPOOL_BUFFERS];
+            if(!Failed && fd -> Write(b -> Data,b -> Length) != b -> Length) {
+                Failed = true;
+            }
+            ++Writes;
+            InterlockedIncrement(&Tail);
+            Done -> SetEvent();
+            continue;
+        }
+        if(Terminated) {
+            break;
+        }
+        Wake -> WaitFor(INFINITE);
+    }
+}
+
+//  Private method to add data to the buffer being filled, handing it over
+//  when it fills up.
+
+bool TPrintSpool::Put(const char *data, long length) {
+
+    long n;
+
+    while(length > 0) {
+        if(Fill -> Length == PRINT_SPOOL_BUFFER && !Hand()) {
+            return(false);
+        }
+        n = PRINT_SPOOL_BUFFER - Fill -> Length;
+        if(n > length) {
+            n = length;
+        }
+        memcpy(Fill -> Data + Fill -> Length,data,n);
+        Fill -> Length += n;
+        Offset += n;
+        data += n;
+        length -= n;
+    }
+    return(!Failed);
+}
+
+//  Private method to hand the buffer being filled to the thread, and get
+//  the next one - waiting, if need be, for the thread to write one out.
+
+bool TPrintSpool::Hand() {
+
+    if(Fill -> Length == 0) {
+        return(!Failed);
+    }
+
+    InterlockedIncrement(&Head);
+    Wake -> SetEvent();
+
+    if(Head - Tail >= PRINT_SPOOL_BUFFERS) {
+        ++Waits;
+        while(Head - Tail >= PRINT_SPOOL_BUFFERS) {
+            Done -> WaitFor(INFINITE);
+        }
+    }
+
+    Fill = &Ring[Head % PRINT_SPOOL_BUFFERS];
+    Fill -> Length = 0;
+    return(!Failed);
+}
+
+//  Spool a print line.  Normally, a print line is followed by a carriage
+//  return (the carriage motion comes separately).  The printer can also
+//  spool part of a line, without the carriage return.
+
+//  (In ASA format, part of a line is just a line).
+
+bool TPrintSpool::Print(const char *line, int length, bool end) {
+
+    if(ASA) {
+        return(PrintASA(line,length));
+    }
+
+    if(TopOfForm) {
+        Page();
+    }
+    Pending = 0;
+    if(!Put(line,length)) {
+        return(false);
+    }
+    if(end) {
+        ++Lines;
+        return(Put("\r",1));
+    }
+    return(true);
+}
+
+//  Private method to spool an ASA format print line, with the carriage
+//  motion since the last one in front of it.
+
+bool TPrintSpool::PrintASA(const char *line, int length) {
+
+    char control;
+
+    while(length > 0 && line[length-1] == ' ') {
+        --length;
+    }
+
+    if(TopOfForm) {
+        Page();
+        if(Pending > 0 && !Put("1\r\n",3)) {
+            return(false);
+        }
+        control = '1';
+    }
+    else {
+        control = '+';
+    }
+
+    while(Pending > 3) {
+        if(!Put("-\r\n",3)) {
+            return(false);
+        }
+        Pending -= 3;
+    }
+    switch(Pending) {
+    case 1:
+        control = ' ';
+        break;
+    case 2:
+        control = '0';
+        break;
+    case 3:
+        control = '-';
+        break;
+    }
+    Pending = 0;
+
+    ++Lines;
+    return(Put(&control,1) && Put(line,length) && Put("\r\n",2));
+}
+
+//  Private method to note that a page starts at the current offset
+
+void TPrintSpool::Page() {
+
+    __int64 *p;
+
+    TopOfForm = false;
+    if(PageCount == PageCapacity) {
+        PageCapacity = PageCapacity == 0 ? 256 : 2 * PageCapacity;
+        p = new __int64[PageCapacity];
+        if(PageCount > 0) {
+            memcpy(p,Pages,PageCount * sizeof(__int64));
+        }
+        delete[] Pages;
+        Pages = p;
+    }
+    Pages[PageCount++] = Offset;
+}
+
+//  Spool carriage motion: some number of lines.  If the carriage reached
+//  channel 1 (top of form) along the way, top is how many lines it moved
+//  after the last time it did.  Otherwise it is -1.
+
+bool TPrintSpool::Space(int lines, int top) {
+
+    static const char crlf[] =
+        "\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n";
+    int n;
+
+    if(top >= 0) {
+        TopOfForm = true;
+        Pending = top;
+    }
+    else {
+        Pending += lines;
+    }
+
+    if(ASA) {
+        return(!Failed);
+    }
+
+    while(lines > 0) {
+        n = lines > 16 ? 16 : lines;
+        if(!Put(crlf,2 * n)) {
+            return(false);
+        }
+        lines -= n;
+    }
+    return(!Failed);
+}
+
+//  Write everything out now (at the end of a job, for example), and wait
+//  until it is done.
+
+bool TPrintSpool::Flush() {
+
+    Hand();
+    while(Tail != Head) {
+        Done -> WaitFor(INFINITE);
+    }
+    return(!Failed);
+}
+
+//  Private method to write the page index file.  (By now the thread is
+//  done, so this is the main thread's business).
+
+bool TPrintSpool::SaveIndex() {
+
+    TFileStream *f;
+    bool ok;
+
+    try {
+        f = new TFileStream(IndexName,fmCreate);
+    }
+    catch(Exception &e) {
+        DEBUG("TPrintSpool::SaveIndex: Cannot create %s",
+            AnsiString(IndexName).c_str());
+        return(false);
+    }
+
+    ok = f -> Write(PRINT_INDEX_MAGIC,8) == 8 &&
+        f -> Write(&PageCount,sizeof(PageCount)) == sizeof(PageCount) &&
+        f -> Write(Pages,PageCount * sizeof(__int64)) ==
+            (int) (PageCount * sizeof(__int64));
+    delete f;
+
+    if(!ok) {
+        DEBUG("TPrintSpool::SaveIndex: Write failed for %s",
+            AnsiString(IndexName).c_str());
+    }
+    return(ok);
+}
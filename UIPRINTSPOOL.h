@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------
+#ifndef UIPRINTSPOOLH
+#define UIPRINTSPOOLH
+//---------------------------------------------------------------------------
+
+#include <System.SyncObjs.hpp>
+
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//  Print spool.  The printer hands the spool whole lines, and carriage
+//  motion as a number of lines, and the spool collects them in a buffer.
+//  When a buffer fills, it goes to a thread of its own, which does the
+//  actual (big) writes to the capture file, while the printer goes on
+//  filling the next buffer in the ring.  The printer only has to wait if
+//  all of the buffers are waiting to be written.
+//
+//  Head is the buffer the printer is filling; Tail is the next one for the
+//  thread to write.  Only the printer moves Head, and only the thread
+//  moves Tail.  A write error is remembered (and the rest of the output
+//  thrown away), and shows up on the next call from the printer.
+
+#define PRINT_SPOOL_BUFFER      262144              //  Bytes per buffer
+#define PRINT_SPOOL_BUFFERS     4                   //  Buffers in the ring
+
+//  There are two capture formats.  The original one is just what the
+//  printer did: each print line followed by a carriage return, and a CR LF
+//  for each line the carriage moves.  The other (used if the capture file
+//  name ends in .asa) is one record per print line, with an ASA carriage
+//  control character in front, trailing blanks dropped, and a CR LF after:
+//
+//      ' '     Space 1 line, then print
+//      '0'     Space 2 lines, then print
+//      '-'     Space 3 lines, then print
+//      '1'     Skip to channel 1 (top of form), then print
+//      '+'     Do not space (overprint)
+//
+//  The printer spaces after it prints, and ASA spaces before, so the
+//  spool holds on to carriage motion until the next line comes along.
+//  Longer moves are written as extra '-' records with nothing on them.
+//
+//  In either format, the spool also keeps a page index: the file offset
+//  of the first line printed after each skip to channel 1.  It is written
+//  when the spool closes, next to the capture file (the capture file name
+//  with .idx tacked on): the magic string, the page count, and then the
+//  offsets.
+
+#define PRINT_INDEX_MAGIC       "1403PIX1"
+
+struct TPrintSpoolBuffer {
+    long Length;
+    char Data[PRINT_SPOOL_BUFFER];
+};
+
+class TPrintSpool : public TThread {
+
+private:
+
+    TFileStream *fd;                                //  Capture file (ours)
+    TEvent *Wake;                                   //  Work for the thread
+    TEvent *Done;                                   //  Thread wrote one
+    TPrintSpoolBuffer *Ring;
+    TPrintSpoolBuffer *Fill;                        //  Ring[Head]
+    volatile long Head;
+    volatile long Tail;
+    volatile bool Failed;                           //  Write error
+
+    bool ASA;                                       //  ASA format
+    __int64 Offset;                                 //  Bytes spooled so far
+    bool TopOfForm;                                 //  Reached channel 1
+    int Pending;                                    //  Lines moved since
+    String IndexName;
+    __int64 *Pages;                                 //  Page index
+    long PageCount, PageCapacity;
+
+    bool Put(const char *data, long length);
+    bool Hand();                                    //  Fill buffer to thread
+    bool PrintASA(const char *line, int length);
+    void Page();                                    //  A page starts here
+    bool SaveIndex();
+
+protected:
+
+    void __fastcall Execute();
+
+public:
+
+    long Lines, Writes, Waits;                      //  Statistics
+
+    __fastcall TPrintSpool(TFileStream *f, String indexname, bool asa);
+    __fastcall ~TPrintSpool();                      //  Writes out the rest
+
+    bool Print(const char *line, int length, bool end = true);
+    bool Space(int lines, int top = -1);            //  Carriage motion
+    inline long GetPages() { return PageCount; }
+    bool Flush();                                   //  Write it all, now
+};
+
+#endif
@@ -1,62 +1,92 @@
-//---------------------------------------------------------------------------
-#ifndef UIPUNCHH
-#define UIPUNCHH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-#define PUNCH_IO_DEVICE 4
-
-class TPunch : public T1410IODevice {
-
-protected:
-
-    int PunchStatus;                                //  Punch status for channel
-    bool Ready;
-
-    TCard *PunchBuffer;                             //  Current output card
-    int column;                                     //  Current output column
-
-    TBusyDevice *BusyEntry;                         //  Used to set delays
-
-public:
-
-    //  Implement the I/O device interface standrad
-
-    TPunch(int devicenum, T1410Channel *Channel);
-    virtual int Select();
-    virtual void DoOutput();
-    virtual void DoInput();
-    virtual int StatusSample();
-    virtual void DoUnitControl(BCD opmod);
-
-    //  State and status methods
-
-    inline bool IsReady() { return Ready; }
-    inline bool IsBusy() { return BusyEntry -> TestBusy(); }
-
-    bool SetUnit(int u);                            //  Check unit validity, set
-
-    bool DoStart();                                 //  Process Start button
-    bool DoStop();                                  //  Process Stop button
-    void DoOutputChar(BCD c);                       //  Punch a column
-};
-
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UIPUNCHH
+#define UIPUNCHH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define PUNCH_IO_DEVICE 4
+
+//  1402 punch timing: 250 cards per minute, so one card cycle takes
+//  240 milliseconds.
+
+#define PUNCH_CARD_CYCLE_MS     240
+
+//  The punch feed hopper holds about 3000 blank cards.  When it runs out,
+//  the punch stops until the operator fills it and presses START.  (The
+//  stackers have their limit too, and both only apply with the CARD
+//  CAPACITY switch on: see THopper).
+
+#define PUNCH_HOPPER_CAPACITY   3000
+
+//  Like the reader, a punch from the device map has hoppers of its own, and
+//  an operator who never lets it run out of blank cards or stacker room.
+
+class TPunch : public T1410IODevice {
+
+protected:
+
+    int PunchStatus;                                //  Punch status for channel
+    bool Ready;
+
+    TCard *PunchBuffer;                             //  Current output card
+    int column;                                     //  Current output column
+
+    TBusyDevice *BusyEntry;                         //  Used to set delays
+
+    long BlankCards;                                //  In the feed hopper
+    TCardStats stats;
+
+    THopper **Hopper;                               //  Stackers P8, P4, P0
+    bool OnPanel;                                   //  False if no 1402 panel
+
+public:
+
+    //  Implement the I/O device interface standrad
+
+    TPunch(int devicenum, T1410Channel *Channel);
+    virtual int Select();
+    virtual void DoOutput();
+    virtual void DoInput();
+    virtual int StatusSample();
+    virtual void DoUnitControl(BCD opmod);
+
+    //  State and status methods
+
+    inline bool IsReady() { return Ready; }
+    inline bool IsBusy() { return BusyEntry -> TestBusy(); }
+
+    bool SetUnit(int u);                            //  Check unit validity, set
+
+    bool DoStart();                                 //  Process Start button
+    bool DoStop();                                  //  Process Stop button
+    void DoOutputChar(BCD c);                       //  Punch a column
+    void Unattended(THopper **hoppers);             //  Not on the 1402 panel
+
+    TCardStats GetStats() { return stats; }
+    void ResetStats();
+    void Report(int ch, __int64 elapsed);           //  For the job report
+
+private:
+
+    void Stopped();                                 //  Full or empty
+};
+
+
+#endif
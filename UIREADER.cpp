@@ -1,506 +1,868 @@
-/*
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-//---------------------------------------------------------------------------
-#include <vcl.h>
-#pragma hdrstop
-
-#include <dir.h>
-#include <stdio.h>
-#include <assert.h>
-#include "ubcd.h"
-#include "UI1410CPUT.h"
-#include "UI1410INST.h"
-#include "UIHOPPER.h"
-#include "UI1410CHANNEL.h"
-#include "UIREADER.h"
-
-//---------------------------------------------------------------------------
-#pragma package(smart_init)
-
-#include "UI1410DEBUG.h"
-#include "UIPUNCH.h"
-#include "UI1402.h"
-
-//  TCardReader Class Implementation
-
-//  Constructor.  Sets up the card reader
-
-TCardReader::TCardReader(int devicenum, T1410Channel *Channel) :
-    T1410IODevice(devicenum, Channel) {
-
-    BusyEntry = new TBusyDevice();
-
-	filename = L"";
-    fd = NULL;
-
-    ReadStation = NULL;
-    CheckStation = NULL;
-    StackStation = NULL;
-    ReadBuffer = NULL;
-
-    ready = eof = buffertransferred = false;
-    readerstatus = column = 0;
-}
-
-//  IO Device Implementation
-
-//  Select.  Returns 0 if successful, non 0 channel status otherwise
-
-int TCardReader::Select() {
-
-    int op;
-
-    column = 1;                                 //  Reset column back to start
-
-    //  Check that the card reader is ready, not busy, that we are doing
-    //  either a read or unit control operation.  If not, return appropriate
-    //  status.
-
-    if(!IsReady()) {
-        return(readerstatus = IOCHNOTREADY);
-    }
-    if(IsBusy()) {
-		return(readerstatus = IOCHBUSY);
-    }
-    if(Channel -> ChWrite -> State()) {
-        return(readerstatus = IOCHNOTREADY);
-    }
-
-    //  If this is a read operation (opcode M or L), and there is
-    //  nothing in the read buffer, and eof is set, return IOCHCONDITION.
-
-    //  If the eof switch is set, we can continue so long as there
-    //  is at least a card at the Read Station.
-
-    //  If the eof switch is not set, and there is no card at the
-    //  check station, return not ready!
-
-    //  If that is all OK, call SetUnit to fill the read buffer and start
-    //  the card transport.
-
-    //  Card transport for SSF is handled in the DoUnitControl method).
-
-    readerstatus = 0;
-
-    //  Nothing more to read, and EOF.  Stack the last card, go not ready,
-    //  and return IOCHCONDITION status for M or L opcode.
-
-    if(ReadStation == NULL && eof) {
-        eof = false;
-        if(StackStation != NULL) {
-            StackStation -> Stack();
-            delete StackStation;
-            StackStation = NULL;
-        }
-        FI1402 -> ResetEOF();
-        FI1402 -> SetReaderReady(false);
-        ready = false;
-		if((op = CPU -> Op_Reg -> Get().To6Bit()) == OP_IO_MOVE ||
-            op == OP_IO_LOAD) {
-            return(readerstatus = IOCHCONDITION);
-        }
-        return(readerstatus = IOCHNOTREADY);
-    }
-
-    //  If there is no card at the Check Station and the EOF switch isn't on,
-    //  Go not ready, and return not ready.
-
-    if(CheckStation == NULL && !eof) {
-        FI1402 -> SetReaderReady(false);
-        ready = false;
-        return(readerstatus = IOCHNOTREADY);
-    }
-
-    //  ReadStation should not be null unless CheckStation is also null...
-
-    assert(ReadStation != NULL);
-
-    if(!SetUnit(Channel -> GetUnitNumber())) {
-        return(readerstatus = IOCHNOTREADY);
-    }
-
-    //  Otherwise, AOK.  (Might be IOCHCONDITION from SetUnit() ).
-
-    return(readerstatus);
-}
-
-//  Card reader unit control - used for Select Stacker and Feed instruction
-
-void TCardReader::DoUnitControl(BCD opmod) {
-
-    int hopper;
-
-	hopper = opmod.To6Bit();
-
-    switch(hopper) {
-
-    case 0:
-        hopper = HOPPER_R0;
-        break;
-    case 1:
-        hopper = HOPPER_R1;
-        break;
-    case 2:
-        hopper = HOPPER_R2;
-        break;
-
-	default:
-        DEBUG("test without parameters");
-        DEBUG("TCardReader::DoUnitControl invalid unit: %d",hopper);
-        Channel -> UnitControlOverlapBusy = NULL;
-        readerstatus |= IOCHNOTREADY;
-        Channel -> ExtEndofTransfer = true;
-        return;
-    }
-
-    TransportCard(hopper);                      //  Move cards along. Stack.
-    buffertransferred = false;                  //  We now have data avail.
-    Channel -> UnitControlOverlapBusy = BusyEntry;  //  Be busy for a while
-    return;
-}
-
-//  Card Readers don't do ouptut very well, do they....
-
-void TCardReader::DoOutput() {
-    readerstatus |= IOCHNOTREADY;
-}
-
-//  Status sample is pretty simple for this device...
-
-int TCardReader::StatusSample() {
-    return(Channel -> GetStatus() | readerstatus);
-}
-
-//  The real meat - input!
-
-void TCardReader::DoInput() {
-
-    bool wm = false;                                //  True if wm in progress
-    BCD c;                                          //  Column as BCD char
-    int card_input_char;                            //  Column as BCD char too
-
-    //  If the read buffer is empty, no transfer.
-    //  (really, this should never happen!)
-
-	if(ReadBuffer == NULL) {
-        readerstatus |= IOCHNOTRANSFER;
-        Channel -> ExtEndofTransfer = true;
-        return;
-    }
-
-    //  Read the next column.  If return value is < 0, then something unusual
-    //  happened.  channel status should already be set, so just return.
-
-    card_input_char = DoInputColumn();              //  Get next column of data
-    if(card_input_char < 0) {
-        return;
-    }
-
-    //  Handle load mode
-
-    if(Channel -> LoadMode && (card_input_char & 0x3f) == (BCD_WS & 0x3f)) {
-        wm = true;
-		card_input_char = DoInputColumn();          //  Read char after ws
-        if(card_input_char < 0) {                   //  Ooops -- off the end
-            return;
-        }
-        if((card_input_char & 0x3f) == (BCD_WS & 0x3f)) {    //  Another WS?
-            wm = false;                             //  Yes.  Throw away WM
-        }
-    }
-
-    //  Convert the character to BCD.  The DoInputColumn routine already
-    //  sets IOCHDATACHECK for invalid characters...
-
-	assert(card_input_char >= 0 && card_input_char <= 63);
-    c = BCD(card_input_char);
-    c.SetOddParity();
-    if(wm) {
-        c.SetWM();
-        c.ComplementCheck();
-    }
-
-    //  Tell the channel we have something for it!
-
-    Channel -> ChannelStrobe(c);
-}
-
-//  Method to handle setting the unit during the select process for Read
-
-bool TCardReader::SetUnit(int u) {
-
-    assert(ReadStation != NULL);
-
-    switch(u) {
-
-    case 0:
-        u = HOPPER_R0;
-		break;
-    case 1:
-        u = HOPPER_R1;
-        break;
-    case 2:
-        u = HOPPER_R2;
-        break;
-
-    case 9:
-        if(buffertransferred) {
-            readerstatus |= IOCHNOTRANSFER;
-            return(true);
-        }
-        ReadBuffer = ReadStation;
-        return(true);
-
-    default:
-        return(false);
-    }
-
-    ReadBuffer = ReadStation;
-    TransportCard(u);
-    return(true);
-
-}
-
-//  Method to transport the cards in the card reader.  The card in the stacking
-//  station gets stacked (and deleted).  The card that was just read gets its
-//  hopper selected, and moves to the Stacking Station.
-//  The card in the Check Station goes to the Reader Station, and we fill the
-//  Check Station with the next card (NULL if none).
-
-void TCardReader::TransportCard(int hopper) {
-
-    if(StackStation != NULL) {
-       StackStation -> Stack();
-       delete StackStation;
-       StackStation = NULL;
-    }
-
-    //  If there is a card to stack, stack it.  For the reader, the array
-    //  indices for the hoppers (see T1410CHANNEL) match up.
-
-    if(ReadStation != NULL) {
-        ReadStation -> SelectStacker(Channel -> Hopper[hopper]);
-    }
-
-    FI1402 -> SetReaderCheck(false);
-    FI1402 -> SetReaderValidity(false);
-    BusyEntry -> SetBusy(2);
-    StackStation = ReadStation;
-    ReadStation = CheckStation;
-
-    if(ready) {
-        CheckStation = FeedCard();
-    }
-    else {
-        CheckStation = NULL;
-    }
-}
-
-//  Method to feed a card from the input hopper.  Returns NULL if there is
-//  an EOF or I/O Error
-
-TCard *TCardReader::FeedCard() {
-
-    TCard *card;
-    char temp[82];
-    char *cp;
-    int i;
-
-    //  If the file isn't open, or we cannot allocate a card, return NULL
-
-	if(fd == NULL || (card = new TCard()) == NULL) {
-        return(NULL);
-    }
-
-    //  Read up to 80 columns, looking for newline.  If we hit EOF first,
-    //  throw away the card.  Replace the newline with a blank.  We have
-    //  to read up to 82 columns to get the newline.
-
-    for(cp = temp; cp - temp < 82; ++cp) {
-        if(fd -> Read(cp,1) != 1) {
-            delete card;
-            delete fd;
-            fd = NULL;
-            return(card = NULL);
-        }
-        if(*cp == '\n') {
-            break;
-        }
-    }
-
-    if(*cp != '\n') {
-        DEBUG("TCardReader::FeedCard: No newline found within 82 characters");
-    }
-
-    //  If the character before the newline was a carriage return, throw it
-    //  away as well.
-
-    if(cp > temp && *(cp-1) == '\r') {
-        *(cp-1) = ' ';
-    }
-
-    //  Change the newline and any trailing garbage to blank.
-
-    for(; cp - temp < 80; ++cp) {
-        *cp = ' ';
-    }
-
-	//  Finally, transfer the card image to the card object.
-
-    for(i=0, cp=temp; i < 80; ++i, ++cp) {
-		card -> image[i] = *cp;
-	}
-	return(card);
-}
-
-//  Method to read one card column.  Returns BCD character as an integer, so
-//  that it also has a way to return EOF/Error status
-
-int TCardReader::DoInputColumn() {
-
-    int ch;
-
-    //  If nothing in the buffer, say so.
-
-    if(ReadBuffer == NULL) {
-        readerstatus |= IOCHNOTRANSFER;
-        Channel -> ExtEndofTransfer = true;
-        return(-1);
-    }
-
-    //  If column is invalid, write to log, and take the reader offline.
-
-    if(column < 1 || column > 81) {
-        DEBUG("TCardReader::DoInputColumn: Invalid column: %d",column);
-        ready = false;
-        readerstatus |= IOCHNOTREADY;
-        FI1402 -> SetReaderReady(false);
-        Channel -> ExtEndofTransfer = true;
-        return(-1);
-    }
-
-    //  If we have read all of the card, set end of transfer flag
-
-    if(column == 81) {
-        ++column;                               //  If it tries again, bad dog.
-        Channel -> ExtEndofTransfer = true;
-        return(-1);
-    }
-
-    //  Otherwise, grab a character from the card image.  Check that it is
-    //  a valid character, and if not, signal a data check, and set the
-    //  reader check light.
-
-    assert(column > 0 && column <= 80);
-	ch = ReadBuffer -> image[column-1];
-	++column;
-    if(BCD::BCDCheck(ch) < 0) {
-        readerstatus |= IOCHDATACHECK;
-        ready = false;
-        FI1402 -> SetReaderCheck(true);
-        FI1402 -> SetReaderValidity(true);
-    }
-	ch = BCD::BCDConvert(ch);                       //  Invalid turns to alt b
-    return(ch);
-}
-
-//  Interface Methods for User Interface
-
-//  Method to load the card file
-
-bool TCardReader::LoadFile(String s) {
-
-	if(fd != NULL) {
-		delete fd;
-		fd = NULL;
-	}
-
-	if(s.Length() == 0) {
-		return(false);
-    }
-
-    try {
-        fd = new TFileStream(s /* .c_str() */,fmOpenRead | fmShareDenyWrite);
-    }
-    catch(EFOpenError &e) {
-        return(false);
-    }
-
-	// strncpy(filename,s,MAXPATH);
-	filename = s;
-    return(true);
-}
-
-//  Forced file close.  Necessary because (apparently) the file open
-//  dialog checks and notices that the file is already open.  This prevents
-//  reloading the same card deck twice in a row if we didn't have this method.
-
-//  It also stacks all of the remaining cards in hopper 0.
-
-void TCardReader::CloseFile() {
-
-    if(fd != NULL) {
-        delete fd;
-        fd = NULL;
-    }
-
-    while(StackStation != NULL) {
-        StackStation -> SelectStacker(Channel -> Hopper[0]);
-        StackStation -> Stack();
-        TransportCard(0);
-    }
-}
-
-//  Method to handle the STOP button
-
-void TCardReader::DoStop() {
-    ready = false;
-    eof = false;
-}
-
-//  Method to handle the START button
-
-bool TCardReader::DoStart() {
-
-    ready = false;
-
-    //  Feed a card into the Check station if it is empty.
-
-    if(CheckStation == NULL) {
-        CheckStation = FeedCard();
-    }
-
-    //  If there is no card at the Read Station, and there is (now) a card
-    //  at the Check Station, move it to the Read Station, and
-    //  feed another card.
-
-    if(ReadStation == NULL && (ReadStation = CheckStation) != NULL) {
-        CheckStation = FeedCard();
-    }
-
-    //  If there is a card at the Check Station, or, if EOF is pressed,
-    //  there is at least a card at the Read Station, all is OK.
-
-    if(CheckStation != NULL || (eof && ReadStation != NULL)) {
-        ready = true;
-    }
-
-    return(ready);
-}
-
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <dir.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UI1410INST.h"
+#include "UIHOPPER.h"
+#include "UI1410CHANNEL.h"
+#include "UIREADER.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+#include "UIPUNCH.h"
+#include "UI1402.h"
+
+//  TCardDeck Class Implementation
+
+bool TCardDeck::TableBuilt = false;
+unsigned char TCardDeck::Table[256];
+
+//  Constructor.  Reads the whole deck file in one go, and splits it into
+//  cards.  If the open fails, the EFOpenError goes to the caller.
+
+//  This may run in a TCardDeckCheck thread, so no DEBUG() here: anything
+//  worth saying goes into Problems.
+
+TCardDeck::TCardDeck(String filename) {
+
+    TFileStream *fd;
+    unsigned char *deck;
+    long size, i;
+    char text[100];
+
+    BuildTable();
+
+    Images = Codes = NULL;
+    Count = Next = 0;
+    Filename = filename;
+    Problems = new TStringList();
+    InvalidColumns = LongLines = LineEnds = ReadErrors = 0;
+
+    try {
+        fd = new TFileStream(filename,fmOpenRead | fmShareDenyWrite);
+    }
+    catch(EFOpenError &e) {
+        delete Problems;
+        throw;
+    }
+
+    size = (long) fd -> Size;
+    deck = new unsigned char[size > 0 ? size : 1];
+    if(fd -> Read(deck,size) != size) {
+        Problem(ReadErrors,"Short read: the deck is treated as empty");
+        size = 0;
+    }
+    delete fd;
+
+    //  Count the cards, then split them out, and translate them.
+
+    Count = Split(deck,size,NULL);
+    Images = new unsigned char[Count * 80 + 1];
+    Codes = new unsigned char[Count * 80 + 1];
+    Split(deck,size,Images);
+    delete[] deck;
+
+    //  A carriage return that is not right before a newline ends up in
+    //  the card, where it is a line ending problem more than a bad
+    //  character, so it is reported that way.
+
+    for(i=0; i < Count * 80; ++i) {
+        Codes[i] = Table[Images[i]];
+        if(Codes[i] & CARD_CODE_INVALID) {
+            if(Images[i] == '\r') {
+                sprintf(text,"Card %ld column %ld: stray carriage return",
+                    i / 80 + 1,i % 80 + 1);
+                Problem(LineEnds,text);
+            }
+            else {
+                sprintf(text,"Card %ld column %ld: invalid character 0x%02x",
+                    i / 80 + 1,i % 80 + 1,Images[i]);
+                Problem(InvalidColumns,text);
+            }
+        }
+    }
+}
+
+TCardDeck::~TCardDeck() {
+    delete[] Images;
+    delete[] Codes;
+    delete Problems;
+}
+
+//  Build the translate table: each ASCII character to its BCD equivalent,
+//  with the invalid ones flagged (and translated to alternate blank, just
+//  as BCDConvert does).  Call this from the main thread before starting
+//  any TCardDeckCheck threads, so that they don't all build it at once.
+
+void TCardDeck::BuildTable() {
+
+    int i;
+
+    if(TableBuilt) {
+        return;
+    }
+    for(i=0; i < 256; ++i) {
+        Table[i] = (unsigned char) BCD::BCDConvert(i);
+        if(BCD::BCDCheck(i) < 0) {
+            Table[i] |= CARD_CODE_INVALID;
+        }
+    }
+    TableBuilt = true;
+}
+
+//  Private method to split the deck up into cards, one per line.  Returns
+//  the number of cards.  Only counts them if images is NULL.
+
+//  A line is up to 80 columns, and we look up to 82 characters for the
+//  newline.  A carriage return before the newline is thrown away, and
+//  the newline and anything after it is blank.  If there is no newline
+//  within 82 characters, the card is the first 80, and the next card
+//  starts after the 82nd.  A last line without a newline is thrown away.
+
+//  When splitting for real, the lines that lose something are noted.
+
+long TCardDeck::Split(const unsigned char *deck, long size,
+    unsigned char *images) {
+
+    long pos = 0, count = 0, n, len;
+    long crlf = 0, lf = 0;
+    unsigned char *card;
+    char text[100];
+
+    while(pos < size) {
+        for(n=0; n < 82 && pos + n < size && deck[pos + n] != '\n'; ++n)
+            ;
+        if(n < 82 && pos + n >= size) {             //  EOF before newline
+            if(images != NULL) {
+                sprintf(text,"Last line (%ld characters) has no newline, "
+                    "and is ignored",n);
+                Problem(LineEnds,text);
+            }
+            break;
+        }
+
+        if(images != NULL) {
+            card = images + count * 80;
+            len = n;
+            if(len < 82 && len > 0 && deck[pos + len - 1] == '\r') {
+                --len;
+                ++crlf;
+            }
+            else if(n < 82) {
+                ++lf;
+            }
+            if(n == 82) {
+                sprintf(text,"Card %ld: no newline found within 82 characters",
+                    count + 1);
+                Problem(LongLines,text);
+            }
+            else if(len > 80) {
+                sprintf(text,"Card %ld: line is %ld columns, the rest "
+                    "is ignored",count + 1,len);
+                Problem(LongLines,text);
+            }
+            if(len > 80) {
+                len = 80;
+            }
+            memcpy(card,deck + pos,len);
+            memset(card + len,' ',80 - len);
+        }
+
+        pos += (n < 82) ? n + 1 : 82;
+        ++count;
+    }
+
+    //  Either line ending is fine, but not both in the same deck: that
+    //  usually means it was pasted together from different places.
+
+    if(images != NULL && crlf > 0 && lf > 0) {
+        sprintf(text,"Mixed line endings: %ld CR LF, %ld LF only",crlf,lf);
+        Problem(LineEnds,text);
+    }
+
+    return(count);
+}
+
+//  Note a problem.  Count it, and keep the text if we are not already
+//  keeping too many.
+
+void TCardDeck::Problem(long &counter, const char *text) {
+
+    ++counter;
+    if(Problems -> Count < CARD_DECK_MAX_PROBLEMS) {
+        Problems -> Add(String(text));
+    }
+}
+
+//  One line summary of what is wrong with a deck
+
+String TCardDeck::Summary() {
+
+    char text[200];
+
+    sprintf(text,"%ld cards, %ld invalid columns, %ld long lines, "
+        "%ld line ending problems",
+        Count,InvalidColumns,LongLines,LineEnds);
+    return(String(text));
+}
+
+//  Report on a deck in the debug log (main thread only).  Just the file
+//  name goes in, since a whole path could overrun the debug line.
+
+void TCardDeck::Report() {
+
+    int i;
+
+    DEBUG("Card deck %s: %s",AnsiString(ExtractFileName(Filename)).c_str(),
+        AnsiString(Summary()).c_str());
+    for(i=0; i < Problems -> Count; ++i) {
+        DEBUG("    %s",AnsiString(Problems -> Strings[i]).c_str());
+    }
+    if(GetProblems() > Problems -> Count) {
+        DEBUG("    (and %ld more)",GetProblems() - Problems -> Count);
+    }
+}
+
+//  TCardDeckCheck Class Implementation
+
+__fastcall TCardDeckCheck::TCardDeckCheck(String filename) : TThread(true) {
+
+    Filename = filename;
+    Deck = NULL;
+    Start();
+}
+
+__fastcall TCardDeckCheck::~TCardDeckCheck() {
+
+    WaitFor();
+    if(Deck != NULL) {
+        delete Deck;
+    }
+}
+
+void __fastcall TCardDeckCheck::Execute() {
+
+    try {
+        Deck = new TCardDeck(Filename);
+    }
+    catch(EFOpenError &e) {
+        Deck = NULL;
+    }
+}
+
+//  Check a list of decks, several at once, and report on them in the debug
+//  log, in order.  No more than CARD_DECK_CHECK_THREADS are being checked
+//  (or waiting to be reported) at a time: each time one is reported, the
+//  next one is started.  Returns the total number of problems found (a
+//  deck that will not open counts as one).
+
+long TCardDeckCheck::CheckDecks(TStrings *files) {
+
+    TCardDeckCheck **check;
+    long problems = 0;
+    int i, next;
+
+    TCardDeck::BuildTable();
+
+    check = new TCardDeckCheck *[files -> Count + 1];
+    for(next=0; next < files -> Count && next < CARD_DECK_CHECK_THREADS;
+        ++next) {
+        check[next] = new TCardDeckCheck(files -> Strings[next]);
+    }
+
+    for(i=0; i < files -> Count; ++i) {
+        check[i] -> WaitFor();
+        if(check[i] -> Deck == NULL) {
+            DEBUG("Card deck %s: unable to open",
+                AnsiString(ExtractFileName(files -> Strings[i])).c_str());
+            ++problems;
+        }
+        else {
+            check[i] -> Deck -> Report();
+            problems += check[i] -> Deck -> GetProblems();
+        }
+        delete check[i];
+        if(next < files -> Count) {
+            check[next] = new TCardDeckCheck(files -> Strings[next]);
+            ++next;
+        }
+    }
+
+    delete[] check;
+    return(problems);
+}
+
+//  Feed the next card into card: its image and BCD code.  Returns false
+//  if the deck is all gone.
+
+bool TCardDeck::Feed(TCard *card) {
+
+    if(Next >= Count) {
+        return(false);
+    }
+    memcpy(card -> image,Images + Next * 80,80);
+    memcpy(card -> code,Codes + Next * 80,80);
+    ++Next;
+    return(true);
+}
+
+//  TCardReader Class Implementation
+
+//  Constructor.  Sets up the card reader
+
+TCardReader::TCardReader(int devicenum, T1410Channel *Channel) :
+    T1410IODevice(devicenum, Channel) {
+
+    BusyEntry = new TBusyDevice();
+
+	filename = L"";
+    Deck = NULL;
+
+    ReadStation = NULL;
+    CheckStation = NULL;
+    StackStation = NULL;
+    ReadBuffer = NULL;
+
+    ready = eof = buffertransferred = false;
+    readerstatus = column = 0;
+
+    hoppercards = 0;
+    Hopper = Channel -> Hopper;
+    OnPanel = true;
+    ResetStats();
+}
+
+//  IO Device Implementation
+
+//  Select.  Returns 0 if successful, non 0 channel status otherwise
+
+int TCardReader::Select() {
+
+    int op;
+
+    column = 1;                                 //  Reset column back to start
+
+    //  Check that the card reader is ready, not busy, that we are doing
+    //  either a read or unit control operation.  If not, return appropriate
+    //  status.
+
+    if(!IsReady()) {
+        return(readerstatus = IOCHNOTREADY);
+    }
+    if(IsBusy()) {
+		return(readerstatus = IOCHBUSY);
+    }
+    if(Channel -> ChWrite -> State()) {
+        return(readerstatus = IOCHNOTREADY);
+    }
+
+    //  If this is a read operation (opcode M or L), and there is
+    //  nothing in the read buffer, and eof is set, return IOCHCONDITION.
+
+    //  If the eof switch is set, we can continue so long as there
+    //  is at least a card at the Read Station.
+
+    //  If the eof switch is not set, and there is no card at the
+    //  check station, return not ready!
+
+    //  If that is all OK, call SetUnit to fill the read buffer and start
+    //  the card transport.
+
+    //  Card transport for SSF is handled in the DoUnitControl method).
+
+    readerstatus = 0;
+
+    //  Nothing more to read, and EOF.  Stack the last card, go not ready,
+    //  and return IOCHCONDITION status for M or L opcode.
+
+    if(ReadStation == NULL && eof) {
+        eof = false;
+        StackCard();
+        if(OnPanel) {
+            FI1402 -> ResetEOF();
+            FI1402 -> SetReaderReady(false);
+        }
+        ready = false;
+		if((op = CPU -> Op_Reg -> Get().To6Bit()) == OP_IO_MOVE ||
+            op == OP_IO_LOAD) {
+            return(readerstatus = IOCHCONDITION);
+        }
+        return(readerstatus = IOCHNOTREADY);
+    }
+
+    //  If there is no card at the Check Station and the EOF switch isn't on,
+    //  Go not ready, and return not ready.
+
+    if(CheckStation == NULL && !eof) {
+        if(OnPanel) {
+            FI1402 -> SetReaderReady(false);
+        }
+        ready = false;
+        if(Deck != NULL && Deck -> GetRemaining() > 0) {
+            ++stats.HopperEmptyStops;           //  Hopper empty, not deck
+            stats.LastStop = TVirtualClock::Now();
+        }
+        return(readerstatus = IOCHNOTREADY);
+    }
+
+    //  ReadStation should not be null unless CheckStation is also null...
+
+    assert(ReadStation != NULL);
+
+    if(!SetUnit(Channel -> GetUnitNumber())) {
+        return(readerstatus = IOCHNOTREADY);
+    }
+
+    //  Otherwise, AOK.  (Might be IOCHCONDITION from SetUnit() ).
+
+    return(readerstatus);
+}
+
+//  Card reader unit control - used for Select Stacker and Feed instruction
+
+void TCardReader::DoUnitControl(BCD opmod) {
+
+    int hopper;
+
+	hopper = opmod.To6Bit();
+
+    switch(hopper) {
+
+    case 0:
+        hopper = HOPPER_R0;
+        break;
+    case 1:
+        hopper = HOPPER_R1;
+        break;
+    case 2:
+        hopper = HOPPER_R2;
+        break;
+
+	default:
+        DEBUG("test without parameters");
+        DEBUG("TCardReader::DoUnitControl invalid unit: %d",hopper);
+        Channel -> UnitControlOverlapBusy = NULL;
+        readerstatus |= IOCHNOTREADY;
+        Channel -> ExtEndofTransfer = true;
+        return;
+    }
+
+    TransportCard(hopper);                      //  Move cards along. Stack.
+    buffertransferred = false;                  //  We now have data avail.
+    Channel -> UnitControlOverlapBusy = BusyEntry;  //  Be busy for a while
+    return;
+}
+
+//  Card Readers don't do ouptut very well, do they....
+
+void TCardReader::DoOutput() {
+    readerstatus |= IOCHNOTREADY;
+}
+
+//  Status sample is pretty simple for this device...
+
+int TCardReader::StatusSample() {
+    return(Channel -> GetStatus() | readerstatus);
+}
+
+//  The real meat - input!
+
+void TCardReader::DoInput() {
+
+    bool wm = false;                                //  True if wm in progress
+    BCD c;                                          //  Column as BCD char
+    int card_input_char;                            //  Column as BCD char too
+
+    //  If the read buffer is empty, no transfer.
+    //  (really, this should never happen!)
+
+	if(ReadBuffer == NULL) {
+        readerstatus |= IOCHNOTRANSFER;
+        Channel -> ExtEndofTransfer = true;
+        return;
+    }
+
+    //  Read the next column.  If return value is < 0, then something unusual
+    //  happened.  channel status should already be set, so just return.
+
+    card_input_char = DoInputColumn();              //  Get next column of data
+    if(card_input_char < 0) {
+        return;
+    }
+
+    //  Handle load mode
+
+    if(Channel -> LoadMode && (card_input_char & 0x3f) == (BCD_WS & 0x3f)) {
+        wm = true;
+		card_input_char = DoInputColumn();          //  Read char after ws
+        if(card_input_char < 0) {                   //  Ooops -- off the end
+            return;
+        }
+        if((card_input_char & 0x3f) == (BCD_WS & 0x3f)) {    //  Another WS?
+            wm = false;                             //  Yes.  Throw away WM
+        }
+    }
+
+    //  Convert the character to BCD.  The DoInputColumn routine already
+    //  sets IOCHDATACHECK for invalid characters...
+
+	assert(card_input_char >= 0 && card_input_char <= 63);
+    c = BCD(card_input_char);
+    c.SetOddParity();
+    if(wm) {
+        c.SetWM();
+        c.ComplementCheck();
+    }
+
+    //  Tell the channel we have something for it!
+
+    Channel -> ChannelStrobe(c);
+}
+
+//  Method to handle setting the unit during the select process for Read
+
+bool TCardReader::SetUnit(int u) {
+
+    assert(ReadStation != NULL);
+
+    switch(u) {
+
+    case 0:
+        u = HOPPER_R0;
+		break;
+    case 1:
+        u = HOPPER_R1;
+        break;
+    case 2:
+        u = HOPPER_R2;
+        break;
+
+    case 9:
+        if(buffertransferred) {
+            readerstatus |= IOCHNOTRANSFER;
+            return(true);
+        }
+        ReadBuffer = ReadStation;
+        return(true);
+
+    default:
+        return(false);
+    }
+
+    ReadBuffer = ReadStation;
+    TransportCard(u);
+    return(true);
+
+}
+
+//  Method to transport the cards in the card reader.  The card in the stacking
+//  station gets stacked (and deleted).  The card that was just read gets its
+//  hopper selected, and moves to the Stacking Station.
+//  The card in the Check Station goes to the Reader Station, and we fill the
+//  Check Station with the next card (NULL if none).
+
+void TCardReader::TransportCard(int hopper) {
+
+    StackCard();
+
+    //  If there is a card to stack, stack it.  For the reader, the array
+    //  indices for the hoppers (see T1410CHANNEL) match up.
+
+    if(ReadStation != NULL) {
+        ReadStation -> SelectStacker(Hopper[hopper]);
+    }
+
+    if(OnPanel) {
+        FI1402 -> SetReaderCheck(false);
+        FI1402 -> SetReaderValidity(false);
+    }
+    BusyEntry -> SetBusy(READER_CARD_CYCLE_MS);
+    stats.BusyCycles += READER_CARD_CYCLE_MS * BUSY_CYCLES_PER_MS;
+    if(ReadStation != NULL) {
+        ++stats.Cards;
+    }
+    StackStation = ReadStation;
+    ReadStation = CheckStation;
+
+    if(ready) {
+        CheckStation = FeedCard();
+    }
+    else {
+        CheckStation = NULL;
+    }
+}
+
+//  Method to stack the card in the Stacking Station, if any.  If that
+//  fills up its stacker, the reader stops, and the STACKER light comes on.
+
+void TCardReader::StackCard() {
+
+    THopper *h;
+
+    if(StackStation == NULL) {
+        return;
+    }
+
+    StackStation -> Stack();
+    h = StackStation -> GetHopper();
+    StackStation -> Release();
+    StackStation = NULL;
+
+    if(h != NULL && h -> IsFull() && ready && OnPanel) {
+        ready = false;
+        FI1402 -> SetReaderReady(false);
+        FI1402 -> CheckStacker();
+        ++stats.StackerFullStops;
+        stats.LastStop = TVirtualClock::Now();
+    }
+}
+
+//  Method to feed a card from the input hopper.  Returns NULL if the
+//  hopper is empty (and then gets rid of the deck, if it is all gone).
+
+TCard *TCardReader::FeedCard() {
+
+    TCard *card;
+
+	if(Deck == NULL || hoppercards <= 0) {
+        return(NULL);
+    }
+
+    card = TCard::Allocate();
+    if(!Deck -> Feed(card)) {
+        card -> Release();
+        delete Deck;
+        Deck = NULL;
+        hoppercards = 0;
+        return(NULL);
+    }
+    --hoppercards;
+	return(card);
+}
+
+//  Method to read one card column.  Returns BCD character as an integer, so
+//  that it also has a way to return EOF/Error status
+
+int TCardReader::DoInputColumn() {
+
+    int ch;
+
+    //  If nothing in the buffer, say so.
+
+    if(ReadBuffer == NULL) {
+        readerstatus |= IOCHNOTRANSFER;
+        Channel -> ExtEndofTransfer = true;
+        return(-1);
+    }
+
+    //  If column is invalid, write to log, and take the reader offline.
+
+    if(column < 1 || column > 81) {
+        DEBUG("TCardReader::DoInputColumn: Invalid column: %d",column);
+        ready = false;
+        readerstatus |= IOCHNOTREADY;
+        if(OnPanel) {
+            FI1402 -> SetReaderReady(false);
+        }
+        Channel -> ExtEndofTransfer = true;
+        return(-1);
+    }
+
+    //  If we have read all of the card, set end of transfer flag
+
+    if(column == 81) {
+        ++column;                               //  If it tries again, bad dog.
+        Channel -> ExtEndofTransfer = true;
+        return(-1);
+    }
+
+    //  Otherwise, grab a character from the card.  It was already
+    //  converted to BCD when the deck was loaded (invalid characters to
+    //  alternate blank).  If it wasn't a valid character, signal a data
+    //  check, and set the reader check light.
+
+    assert(column > 0 && column <= 80);
+	ch = ReadBuffer -> code[column-1];
+	++column;
+    if(ch & CARD_CODE_INVALID) {
+        readerstatus |= IOCHDATACHECK;
+        ready = false;
+        if(OnPanel) {
+            FI1402 -> SetReaderCheck(true);
+            FI1402 -> SetReaderValidity(true);
+        }
+    }
+    return(ch & 0x3f);
+}
+
+//  Interface Methods for User Interface
+
+//  Method to load the card file
+
+bool TCardReader::LoadFile(String s) {
+
+	if(Deck != NULL) {
+		delete Deck;
+		Deck = NULL;
+	}
+
+	if(s.Length() == 0) {
+		return(false);
+    }
+
+    try {
+        Deck = new TCardDeck(s);
+    }
+    catch(EFOpenError &e) {
+        return(false);
+    }
+
+    if(Deck -> GetProblems() > 0) {
+        Deck -> Report();
+    }
+
+	// strncpy(filename,s,MAXPATH);
+	filename = s;
+    hoppercards = 0;                            //  Goes in on START
+    return(true);
+}
+
+//  Forced file close.  Necessary because (apparently) the file open
+//  dialog checks and notices that the file is already open.  This prevents
+//  reloading the same card deck twice in a row if we didn't have this method.
+
+//  It also stacks all of the remaining cards in hopper 0.
+
+void TCardReader::CloseFile() {
+
+    if(Deck != NULL) {
+        delete Deck;
+        Deck = NULL;
+    }
+    hoppercards = 0;
+
+    while(StackStation != NULL) {
+        StackStation -> SelectStacker(Hopper[0]);
+        StackStation -> Stack();
+        TransportCard(0);
+    }
+}
+
+//  Method to handle the STOP button
+
+void TCardReader::DoStop() {
+    ready = false;
+    eof = false;
+}
+
+//  Method to handle the START button
+
+bool TCardReader::DoStart() {
+
+    int i;
+
+    ready = false;
+
+    //  The operator empties any full stackers, and fills the feed hopper
+    //  back up from the deck.
+
+    for(i = HOPPER_R0; i <= HOPPER_R2; ++i) {
+        if(Hopper[i] -> IsFull()) {
+            Hopper[i] -> Empty();
+        }
+    }
+    if(OnPanel) {
+        FI1402 -> CheckStacker();
+    }
+
+    if(Deck != NULL) {
+        hoppercards = Deck -> GetRemaining();
+        if(hoppercards > READER_HOPPER_CAPACITY && OnPanel &&
+            THopper::CapacityLimits) {
+            hoppercards = READER_HOPPER_CAPACITY;
+        }
+    }
+
+    //  Feed a card into the Check station if it is empty.
+
+    if(CheckStation == NULL) {
+        CheckStation = FeedCard();
+    }
+
+    //  If there is no card at the Read Station, and there is (now) a card
+    //  at the Check Station, move it to the Read Station, and
+    //  feed another card.
+
+    if(ReadStation == NULL && (ReadStation = CheckStation) != NULL) {
+        CheckStation = FeedCard();
+    }
+
+    //  If there is a card at the Check Station, or, if EOF is pressed,
+    //  there is at least a card at the Read Station, all is OK.
+
+    if(CheckStation != NULL || (eof && ReadStation != NULL)) {
+        ready = true;
+    }
+
+    return(ready);
+}
+
+//  A reader from the device map: use its own hoppers, and leave the panel
+//  alone.  (The device map then loads its deck and starts it.)
+
+void TCardReader::Unattended(THopper **hoppers) {
+    Hopper = hoppers;
+    OnPanel = false;
+}
+
+//  Statistics, for the job report
+
+void TCardReader::ResetStats() {
+    memset(&stats,0,sizeof(stats));
+}
+
+void TCardReader::Report(int ch, __int64 elapsed) {
+
+    if(stats.Cards == 0 && stats.StackerFullStops == 0 &&
+        stats.HopperEmptyStops == 0) {
+        return;
+    }
+
+    DEBUG("  Channel %d reader %c: %ld cards, %.0f per minute, busy %d%% "
+        "of the job",ch+1,GetUnitType(),stats.Cards,
+        elapsed > 0 ? stats.Cards * 60.0 / TVirtualClock::Seconds(elapsed) : 0.0,
+        (int) (elapsed > 0 ? (100 * stats.BusyCycles) / elapsed : 0));
+    if(stats.StackerFullStops != 0 || stats.HopperEmptyStops != 0) {
+        DEBUG("  Channel %d reader %c: stopped %ld times for a full stacker, "
+            "%ld for an empty hopper (last at %.3f sec)",ch+1,GetUnitType(),
+            stats.StackerFullStops,stats.HopperEmptyStops,
+            TVirtualClock::Seconds(
+                stats.LastStop - (TVirtualClock::Now() - elapsed)));
+    }
+}
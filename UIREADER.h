@@ -1,89 +1,204 @@
-//---------------------------------------------------------------------------
-#ifndef UIREADERH
-#define UIREADERH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-#define READER_IO_DEVICE 1
-
-//  Class to implement the card reader interface and buffer
-
-
-
-class TCardReader : public T1410IODevice {
-
-protected:
-
-	TCard *ReadStation;                         //  Station to read the card
-	TCard *CheckStation;                        //  Where feed goes to
-	TCard *StackStation;                        //  Card after read
-	TCard *ReadBuffer;                          //  Where the read card goes
-
-	String filename;			                //  Input hopper, if you will
-	TFileStream *fd;                            //  Input hopper file stream
-
-	int column;                                 //  Current column.  1-80, 81
-
-    bool ready;                                 //  True if reader ready
-    bool eof;                                   //  True if EOF switch on
-    bool buffertransferred;                     //  True if no data at Check Stn
-
-    int unit;                                   //  Hopper number: 0, 1, 2
-
-    int readerstatus;                           //  Channel status value
-    TBusyDevice *BusyEntry;
-
-public:
-
-    //  Implement the I/O device interface standard
-
-    TCardReader(int devicenum, T1410Channel *Channel);
-    virtual int Select();
-    virtual void DoOutput();
-    virtual void DoInput();
-    virtual int StatusSample();
-    virtual void DoUnitControl(BCD opmod);
-
-    //  State and status methods
-
-    inline bool IsReady() { return ready; }
-    inline void SetEOF() { eof = true; }
-    inline void ResetEOF() { eof = false; }
-    inline bool IsBusy() { return BusyEntry -> TestBusy(); }
-    inline String GetFileName() { return filename; }
-    bool SetUnit(int u);                        //  Check unit validity, set
-    inline int GetUnit() { return unit; }
-
-	bool LoadFile(String s);		            //  Call to open input file
-    void CloseFile();                           //  Force a file close if open
-    bool DoStart();                             //  Process Start Button
-	void DoStop();                              //  Process Stop Button
-
-private:
-
-    void TransportCard(int hopper);             //  Transport card to hopper
-    TCard *FeedCard();                          //  Feed card from input file
-    int DoInputColumn();                        //  Process one card column
-
-};
-
-
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UIREADERH
+#define UIREADERH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define READER_IO_DEVICE 1
+
+//  1402 reader timing: 800 cards per minute, so one card cycle takes
+//  75 milliseconds.
+
+#define READER_CARD_CYCLE_MS    75
+
+//  The 1402 feed hopper holds about 3000 cards.  A bigger deck goes in
+//  3000 cards at a time: when the hopper runs dry the reader stops, and
+//  the operator puts in more (presses START).  (Only with the CARD
+//  CAPACITY switch on: see THopper).
+
+#define READER_HOPPER_CAPACITY  3000
+
+//  In TCard code[], columns that are not valid characters are flagged
+
+#define CARD_CODE_INVALID   0x80
+
+//  A card deck.  The whole deck file is read in at once when it is loaded,
+//  and split into 80 column card images, each with its BCD translation
+//  (checked and converted once, here, rather than a column at a time as
+//  the cards are read).
+
+//  While it is at it, the deck checks itself: invalid columns, lines that
+//  are too long, and line ending oddities (a stray carriage return, a mix
+//  of CR LF and bare LF lines, or a last line with no newline, which gets
+//  dropped).  The first CARD_DECK_MAX_PROBLEMS of these are kept, so that
+//  they can be reported before the deck goes into the hopper.  After that
+//  they are just counted.
+
+#define CARD_DECK_MAX_PROBLEMS  100
+
+class TCardDeck : public TObject {
+
+private:
+
+    unsigned char *Images;                      //  Count cards of 80 columns
+    unsigned char *Codes;                       //  BCD for each column
+    long Count;                                 //  Number of cards
+    long Next;                                  //  Next card to feed
+
+    String Filename;
+    TStringList *Problems;                      //  What is wrong, if anything
+    long InvalidColumns;                        //  Characters with no BCD
+    long LongLines;                             //  Over 80 columns
+    long LineEnds;                              //  CR / LF anomalies
+    long ReadErrors;                            //  Short reads
+
+    static bool TableBuilt;
+    static unsigned char Table[256];            //  ASCII to BCD, and flag
+
+    long Split(const unsigned char *deck, long size, unsigned char *images);
+    void Problem(long &counter, const char *text);
+
+public:
+
+    TCardDeck(String filename);                 //  Throws EFOpenError
+    ~TCardDeck();
+
+    static void BuildTable();                   //  Translate table
+
+    bool Feed(TCard *card);                     //  False if none left
+    inline long GetCount() { return Count; }
+    inline long GetRemaining() { return Count - Next; }
+
+    inline long GetProblems() {
+        return InvalidColumns + LongLines + LineEnds + ReadErrors;
+    }
+    String Summary();                           //  One line, for a message
+    void Report();                              //  All of it, to debug log
+};
+
+//  Check a deck in a thread of its own, so that a bunch of decks can be
+//  checked at once.  The deck is left in Deck (NULL if it would not open)
+//  for the main thread to report on - the debug log is not ours to touch.
+//  Only a few of them run at once, however many decks there are.
+
+#define CARD_DECK_CHECK_THREADS 4                   //  At a time
+
+class TCardDeckCheck : public TThread {
+
+private:
+
+    String Filename;
+
+protected:
+
+    void __fastcall Execute();
+
+public:
+
+    TCardDeck *Deck;
+
+    __fastcall TCardDeckCheck(String filename);
+    __fastcall ~TCardDeckCheck();
+
+    static long CheckDecks(TStrings *files);    //  Returns problem count
+};
+
+//  Class to implement the card reader interface and buffer
+
+//  The reader on the 1402 panel stacks into the channel hoppers.  A reader
+//  attached from the device map (see UIDEVMAP) has its own hoppers, and
+//  nobody at a panel: its whole deck goes into the feed hopper at once, its
+//  stackers never stop it, and it runs with the EOF switch on, so the last
+//  card gives the program its end of file.
+
+
+class TCardReader : public T1410IODevice {
+
+protected:
+
+	TCard *ReadStation;                         //  Station to read the card
+	TCard *CheckStation;                        //  Where feed goes to
+	TCard *StackStation;                        //  Card after read
+	TCard *ReadBuffer;                          //  Where the read card goes
+
+	String filename;			                //  Input hopper, if you will
+	TCardDeck *Deck;                            //  Cards in the input hopper
+
+	int column;                                 //  Current column.  1-80, 81
+
+    bool ready;                                 //  True if reader ready
+    bool eof;                                   //  True if EOF switch on
+    bool buffertransferred;                     //  True if no data at Check Stn
+
+    int unit;                                   //  Hopper number: 0, 1, 2
+
+    int readerstatus;                           //  Channel status value
+    TBusyDevice *BusyEntry;
+
+    long hoppercards;                           //  Cards in the feed hopper
+    TCardStats stats;
+
+    THopper **Hopper;                           //  Stackers R0, R1, R2
+    bool OnPanel;                               //  False if no 1402 panel
+
+public:
+
+    //  Implement the I/O device interface standard
+
+    TCardReader(int devicenum, T1410Channel *Channel);
+    virtual int Select();
+    virtual void DoOutput();
+    virtual void DoInput();
+    virtual int StatusSample();
+    virtual void DoUnitControl(BCD opmod);
+
+    //  State and status methods
+
+    inline bool IsReady() { return ready; }
+    inline void SetEOF() { eof = true; }
+    inline void ResetEOF() { eof = false; }
+    inline bool IsBusy() { return BusyEntry -> TestBusy(); }
+    inline String GetFileName() { return filename; }
+    bool SetUnit(int u);                        //  Check unit validity, set
+    inline int GetUnit() { return unit; }
+
+    TCardStats GetStats() { return stats; }
+    void ResetStats();
+    void Report(int ch, __int64 elapsed);       //  For the job report
+
+	bool LoadFile(String s);		            //  Call to open input file
+    void CloseFile();                           //  Force a file close if open
+    inline TCardDeck *GetDeck() { return Deck; }
+    bool DoStart();                             //  Process Start Button
+	void DoStop();                              //  Process Stop Button
+    void Unattended(THopper **hoppers);         //  Not on the 1402 panel
+
+private:
+
+    void TransportCard(int hopper);             //  Transport card to hopper
+    void StackCard();                           //  Stack, check if full
+    TCard *FeedCard();                          //  Feed card from input file
+    int DoInputColumn();                        //  Process one card column
+
+};
+
+
+
+#endif
@@ -0,0 +1,1034 @@
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UITAPEFILE.h"
+#include "UITAPEUNIT.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+
+//  Tape Read Ahead Thread Implementation
+
+//  Constructor.  The thread gets its own handle on the file, so that it
+//  does not move the file position out from under the tape file.  It
+//  starts out idle.
+
+__fastcall TTapePrefetch::TTapePrefetch(String filename) : TThread(true) {
+
+    fd = new TFileStream(filename,fmOpenRead | fmShareDenyNone);
+    Wake = new TEvent(NULL,false,false,"",false);
+    Ring = new TTapePrefetchBlock[TAPE_PREFETCH_BLOCKS];
+    Head = Tail = 0;
+    Generation = 0;
+    RequestStart = -1;
+    Hits = Misses = 0;
+    Start();
+}
+
+__fastcall TTapePrefetch::~TTapePrefetch() {
+
+    Terminate();
+    Wake -> SetEvent();
+    WaitFor();
+
+    DEBUG("TTapePrefetch: %ld blocks read ahead, %ld misses",Hits,Misses);
+
+    delete fd;
+    delete Wake;
+    delete[] Ring;
+}
+
+//  The thread itself.  Reads blocks into the ring as long as there is
+//  room, and it has not hit end of file.  Otherwise it waits for the tape
+//  file to take a block or to ask for a new start.
+
+void __fastcall TTapePrefetch::Execute() {
+
+    long gen = 0;
+    __int64 next = -1;
+    TTapePrefetchBlock *b;
+
+    while(!Terminated) {
+
+        if(gen != Generation) {
+            gen = Generation;
+            MemoryBarrier();
+            next = RequestStart;
+            continue;                               //  In case it changed
+        }
+
+        if(next < 0 || Head - Tail >= TAPE_PREFETCH_BLOCKS) {
+            Wake -> WaitFor(INFINITE);
+            continue;
+        }
+
+        b = &Ring[Head % TAPE_PREFETCH_BLOCKS];
+        b -> Start = next;
+        b -> Generation = gen;
+
+        try {
+            fd -> Seek(next,soFromBeginning);
+            b -> Length = fd -> Read(b -> Data,TAPE_FILE_BLOCK);
+        }
+        catch(Exception &e) {
+            b -> Length = -1;
+        }
+
+        if(b -> Length <= 0) {                      //  EOF or error: idle
+            next = -1;
+            continue;
+        }
+
+        InterlockedIncrement(&Head);                //  Publish the block
+        next += TAPE_FILE_BLOCK;
+    }
+}
+
+//  Called by the tape file to get the block at start.  Blocks before it,
+//  or from an old request, are thrown away.  Returns false if we don't
+//  have it (and then the caller has to read it itself).
+
+bool TTapePrefetch::Get(__int64 start, unsigned char *buf, long &length) {
+
+    TTapePrefetchBlock *b;
+
+    while(Tail != Head) {
+        b = &Ring[Tail % TAPE_PREFETCH_BLOCKS];
+        if(b -> Generation == Generation && b -> Start == start) {
+            memcpy(buf,b -> Data,b -> Length);
+            length = b -> Length;
+            InterlockedIncrement(&Tail);
+            Wake -> SetEvent();
+            ++Hits;
+            return(true);
+        }
+        if(b -> Generation == Generation && b -> Start > start) {
+            break;                                  //  We backed up
+        }
+        InterlockedIncrement(&Tail);                //  Stale: toss it
+    }
+
+    ++Misses;
+    return(false);
+}
+
+//  Start reading ahead at a new place
+
+void TTapePrefetch::Restart(__int64 start) {
+    RequestStart = start;
+    MemoryBarrier();
+    InterlockedIncrement(&Generation);
+    Wake -> SetEvent();
+}
+
+//  Stop reading ahead (the tape is being written)
+
+void TTapePrefetch::Stop() {
+    if(RequestStart >= 0) {
+        Restart(-1);
+    }
+}
+
+//  Shared Tape Mapping Implementation
+
+TTapeMapping *TTapeMapping::FirstMapping = NULL;
+
+bool TTapeFile::ReadAhead = true;
+
+//  Private constructor.  Maps the file, if it can.  If not, View is NULL.
+
+TTapeMapping::TTapeMapping(String filename) {
+
+    DWORD low, high;
+
+    FileName = filename;
+    Mapping = NULL;
+    View = NULL;
+    Size = 0;
+    Users = 1;
+    NextMapping = NULL;
+
+    //  Tell Windows we are going to read it front to back, so that it
+    //  reads ahead for us.
+
+    File = CreateFile(filename.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,
+        OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+    if(File == INVALID_HANDLE_VALUE) {
+        File = NULL;
+        return;
+    }
+
+    low = GetFileSize(File,&high);
+    Size = ((__int64) high << 32) | low;
+    if(Size == 0 || Size > 0x7fffffffL) {
+        return;                                     //  Can't map this one
+    }
+
+    Mapping = CreateFileMapping(File,NULL,PAGE_READONLY,0,0,NULL);
+    if(Mapping == NULL) {
+        return;
+    }
+
+    View = (unsigned char *) MapViewOfFile(Mapping,FILE_MAP_READ,0,0,0);
+}
+
+//  Find an existing mapping of the file, or make a new one.  Returns NULL
+//  if the file can't be mapped.
+
+TTapeMapping *TTapeMapping::Open(String filename) {
+
+    TTapeMapping *m;
+
+    filename = ExpandFileName(filename);
+
+    for(m = FirstMapping; m != NULL; m = m -> NextMapping) {
+        if(SameFileName(m -> FileName,filename)) {
+            ++(m -> Users);
+            return(m);
+        }
+    }
+
+    m = new TTapeMapping(filename);
+    if(m -> View == NULL) {
+        DEBUG("TTapeMapping::Open: Unable to map %s",
+            AnsiString(filename).c_str());
+        m -> Close();
+        return(NULL);
+    }
+
+    m -> NextMapping = FirstMapping;
+    FirstMapping = m;
+    return(m);
+}
+
+//  Done with a mapping.  The last one out turns off the lights.
+
+void TTapeMapping::Close() {
+
+    TTapeMapping **mp;
+
+    if(--Users > 0) {
+        return;
+    }
+
+    for(mp = &FirstMapping; *mp != NULL; mp = &((*mp) -> NextMapping)) {
+        if(*mp == this) {
+            *mp = NextMapping;
+            break;
+        }
+    }
+
+    if(View != NULL) {
+        UnmapViewOfFile(View);
+    }
+    if(Mapping != NULL) {
+        CloseHandle(Mapping);
+    }
+    if(File != NULL) {
+        CloseHandle(File);
+    }
+    delete this;
+}
+
+//  Tape File Implementation
+
+//  Constructor.  Opens the file.  If the open fails, the EFOpenError
+//  from TFileStream is passed on to the caller, just as if it had opened
+//  the TFileStream itself.
+
+//  A read only file gets mapped, if possible.  Then the whole file is the
+//  block, and Read never has to load another one.  A SIMH image is read
+//  in and converted, and then it, too, is all one block.
+
+TTapeFile::TTapeFile(String filename, bool readonly) {
+
+    DirtyStart = DirtyEnd = 0;
+    Pos = 0;
+    HostCalls = 0;
+    HostTime = 0;
+    fd = NULL;
+    Map = NULL;
+    Prefetch = NULL;
+    Simh = IsSimhFile(filename);
+    Capacity = 0;
+    SimhMark = 0;
+    SimhMarkFile = 0;
+    SimhDirty = -1;
+
+    if(!Simh && readonly && (Map = TTapeMapping::Open(filename)) != NULL) {
+        Buffer = Map -> View;
+        BufferStart = 0;
+        BufferLength = (long) Map -> Size;
+        Size = Map -> Size;
+        return;
+    }
+
+    fd = new TFileStream(filename,
+        readonly ? fmOpenRead : (fmOpenReadWrite | fmShareDenyWrite));
+
+    BufferStart = 0;
+    BufferLength = 0;
+
+    //  A SIMH image too big to hold in memory can't be used at all.  (We
+    //  must not go on with an empty image, because the first flush would
+    //  then write that back over the file.)
+
+    if(Simh) {
+        Buffer = NULL;
+        if(fd -> Size > TAPE_SIMH_MAX - TAPE_FILE_BLOCK) {
+            DEBUG("TTapeFile: SIMH image %s is too big",
+                AnsiString(ExtractFileName(filename)).c_str());
+            delete fd;
+            throw EFOpenError(String("SIMH tape image is too big: ") +
+                filename);
+        }
+        LoadSimh();
+        return;
+    }
+
+    Buffer = new unsigned char[TAPE_FILE_BLOCK];
+    Size = fd -> Size;
+
+    //  If we can't get a read ahead thread, we can live without it.
+
+    if(ReadAhead) {
+        try {
+            Prefetch = new TTapePrefetch(filename);
+        }
+        catch(Exception &e) {
+            DEBUG("TTapeFile: No read ahead for %s",
+                AnsiString(filename).c_str());
+            Prefetch = NULL;
+        }
+    }
+}
+
+//  Destructor.  Anything not yet written goes out now.
+
+TTapeFile::~TTapeFile() {
+    if(Map != NULL) {
+        Map -> Close();
+        return;
+    }
+    Flush();
+    delete Prefetch;
+    delete fd;
+    delete[] Buffer;
+}
+
+//  Read up to count bytes.  Returns the number actually read, which is
+//  short only at end of file.
+
+int TTapeFile::Read(void *buf, int count) {
+
+    unsigned char *p = (unsigned char *) buf;
+    int done = 0;
+    long offset, n;
+
+    while(count > 0 && Pos < Size) {
+        if(Pos < BufferStart || Pos >= BufferStart + BufferLength) {
+            if(!Load(Pos,true) || BufferLength == 0) {
+                break;
+            }
+        }
+        offset = (long) (Pos - BufferStart);
+        n = BufferLength - offset;
+        if(n > count) {
+            n = count;
+        }
+        if(n == 1) {                                //  The usual case
+            *p = Buffer[offset];
+        }
+        else {
+            memcpy(p,Buffer + offset,n);
+        }
+        p += n;
+        Pos += n;
+        done += n;
+        count -= n;
+    }
+    return(done);
+}
+
+//  Write count bytes.  They just go into the block, to be written out
+//  later.  Returns the number of bytes written (all of them, unless we
+//  could not get a block to put them in).
+
+int TTapeFile::Write(const void *buf, int count) {
+
+    const unsigned char *p = (const unsigned char *) buf;
+    int done = 0;
+    long offset, n;
+    unsigned char *b;
+    __int64 start;
+
+    if(Map != NULL) {                               //  Read only!
+        return(0);
+    }
+
+    //  A SIMH image is all in memory.  Just make room if it has to grow.
+
+    if(Simh) {
+        if(Pos + count > TAPE_SIMH_MAX) {
+            DEBUG("TTapeFile::Write: SIMH image would be too big");
+            return(0);
+        }
+        if(Pos + count > Capacity) {
+            Capacity = (long) (2 * (Pos + count) > TAPE_SIMH_MAX ?
+                TAPE_SIMH_MAX : 2 * (Pos + count));
+            b = new unsigned char[Capacity];
+            memcpy(b,Buffer,BufferLength);
+            delete[] Buffer;
+            Buffer = b;
+        }
+        memcpy(Buffer + Pos,p,count);
+        Pos += count;
+        if(Pos > Size) {
+            Size = Pos;
+            BufferLength = (long) Size;
+        }
+        if(SimhDirty < 0 || Pos - count < SimhDirty) {
+            SimhDirty = (long) (Pos - count);
+        }
+        DirtyEnd = 1;
+        return(count);
+    }
+
+    //  If this would run past the end of the block, flush the block, and
+    //  write the whole thing straight out to the file in one go.  Then
+    //  the next write loads the block that we finished in.
+
+    if(Pos - (Pos % TAPE_FILE_BLOCK) + TAPE_FILE_BLOCK < Pos + count) {
+        if(!Flush()) {
+            return(0);
+        }
+        if(Prefetch != NULL) {
+            Prefetch -> Stop();
+        }
+        start = HostTicks();
+        try {
+            fd -> Seek(Pos,soFromBeginning);
+            done = fd -> Write(p,count);
+        }
+        catch(Exception &e) {
+            DEBUG("TTapeFile::Write: Write failed at %lld",Pos);
+            done = 0;
+        }
+        HostDone(start);
+        if(done < 0) {
+            done = 0;
+        }
+        Pos += done;
+        if(Pos > Size) {
+            Size = Pos;
+        }
+        BufferStart = Pos - (Pos % TAPE_FILE_BLOCK);
+        BufferLength = 0;
+        return(done);
+    }
+
+    while(count > 0) {
+        if(Pos < BufferStart || Pos > BufferStart + BufferLength ||
+           Pos >= BufferStart + TAPE_FILE_BLOCK) {
+            if(!Load(Pos,false)) {
+                break;
+            }
+        }
+        offset = (long) (Pos - BufferStart);
+        n = TAPE_FILE_BLOCK - offset;
+        if(n > count) {
+            n = count;
+        }
+        memcpy(Buffer + offset,p,n);
+
+        if(DirtyEnd == 0) {
+            DirtyStart = offset;
+            DirtyEnd = offset + n;
+        }
+        else {
+            if(offset < DirtyStart) {
+                DirtyStart = offset;
+            }
+            if(offset + n > DirtyEnd) {
+                DirtyEnd = offset + n;
+            }
+        }
+        if(offset + n > BufferLength) {
+            BufferLength = offset + n;
+        }
+
+        p += n;
+        Pos += n;
+        done += n;
+        count -= n;
+        if(Pos > Size) {
+            Size = Pos;
+        }
+    }
+    return(done);
+}
+
+//  Seek.  Just moves our position - no I/O happens until a Read or Write
+//  needs a different block.  Returns the new position.
+
+__int64 TTapeFile::Seek(__int64 offset, unsigned short origin) {
+
+    switch(origin) {
+    case soFromBeginning:
+        Pos = offset;
+        break;
+    case soFromCurrent:
+        Pos += offset;
+        break;
+    case soFromEnd:
+        Pos = Size + offset;
+        break;
+    }
+    if(Pos < 0) {
+        Pos = 0;
+    }
+    return(Pos);
+}
+
+//  Write any modified part of the block out to the file.  Returns false
+//  (and throws the data away) if the write fails.
+
+bool TTapeFile::Flush() {
+
+    long n;
+    __int64 start;
+
+    if(DirtyEnd == 0) {
+        return(true);
+    }
+
+    if(Simh) {
+        return(WriteSimhImage());
+    }
+
+    n = DirtyEnd - DirtyStart;
+    start = HostTicks();
+
+    try {
+        fd -> Seek(BufferStart + DirtyStart,soFromBeginning);
+        if(fd -> Write(Buffer + DirtyStart,n) != n) {
+            DEBUG("TTapeFile::Flush: Write failed at %lld",
+                BufferStart + DirtyStart);
+            DirtyStart = DirtyEnd = 0;
+            HostDone(start);
+            return(false);
+        }
+    }
+    catch(Exception &e) {
+        DEBUG("TTapeFile::Flush: Write failed at %lld",
+            BufferStart + DirtyStart);
+        DirtyStart = DirtyEnd = 0;
+        HostDone(start);
+        return(false);
+    }
+
+    DirtyStart = DirtyEnd = 0;
+    HostDone(start);
+    return(true);
+}
+
+//  Flush, and then make sure that it is really on the disk, not just in
+//  the Windows cache, so that it survives a crash.  A mapped image is
+//  never written, so there is nothing to do for that.
+
+bool TTapeFile::Sync() {
+
+    __int64 start;
+    bool ok;
+
+    if(Map != NULL) {
+        return(true);
+    }
+    if(!Flush()) {
+        return(false);
+    }
+    start = HostTicks();
+    ok = FlushFileBuffers((HANDLE) fd -> Handle);
+    HostDone(start);
+    if(!ok) {
+        DEBUG("TTapeFile::Sync: FlushFileBuffers failed, error %d",
+            GetLastError());
+    }
+    return(ok);
+}
+
+//  Cut the file off at size (used to throw away a half written record
+//  after a crash).  The position is left alone, unless it was past the
+//  new end.
+
+bool TTapeFile::Truncate(__int64 size) {
+
+    __int64 start;
+
+    if(Map != NULL || !Flush()) {
+        return(false);
+    }
+    if(size >= Size) {
+        return(true);
+    }
+
+    if(Simh) {
+        BufferLength = (long) size;
+        if(SimhDirty < 0 || size < SimhDirty) {
+            SimhDirty = (long) size;
+        }
+        DirtyEnd = 1;                               //  Write it back out
+    }
+    else {
+        if(Prefetch != NULL) {
+            Prefetch -> Stop();
+        }
+        start = HostTicks();
+        try {
+            fd -> Size = size;
+        }
+        catch(Exception &e) {
+            DEBUG("TTapeFile::Truncate: Failed at %lld",size);
+            HostDone(start);
+            return(false);
+        }
+        HostDone(start);
+        BufferLength = 0;                           //  Reload next time
+    }
+
+    Size = size;
+    if(Pos > Size) {
+        Pos = Size;
+    }
+    return(true);
+}
+
+//  Host I/O accounting, for the statistics.  Each call we make to the file
+//  on the CPU thread is counted, and timed with the performance counter.
+//  (The read ahead thread is not counted, since nobody waits for it.)
+
+__int64 TTapeFile::HostTicks() {
+
+    LARGE_INTEGER t;
+
+    QueryPerformanceCounter(&t);
+    return(t.QuadPart);
+}
+
+void TTapeFile::HostDone(__int64 start) {
+    ++HostCalls;
+    HostTime += HostTicks() - start;
+}
+
+__int64 TTapeFile::GetHostMicroseconds() {
+
+    LARGE_INTEGER f;
+
+    QueryPerformanceFrequency(&f);
+    return(f.QuadPart > 0 ? HostTime * 1000000 / f.QuadPart : 0);
+}
+
+//  Private method to make the block containing pos the current block.
+//  Blocks start on block boundaries, so that backing up a frame at a
+//  time (Backspace) does not have to re-read the file every time.
+
+bool TTapeFile::Load(__int64 pos, bool reading) {
+
+    __int64 start;
+
+    if(Map != NULL || Simh) {                       //  Already all here
+        return(false);
+    }
+
+    if(!Flush()) {
+        return(false);
+    }
+
+    BufferStart = pos - (pos % TAPE_FILE_BLOCK);
+    BufferLength = 0;
+
+    //  If we are reading, the read ahead thread may already have the
+    //  block.  If it doesn't, have it start over after this one.  If we
+    //  are writing, whatever it has read ahead may soon be out of date.
+
+    if(Prefetch != NULL) {
+        if(!reading) {
+            Prefetch -> Stop();
+        }
+        else if(Prefetch -> Get(BufferStart,Buffer,BufferLength)) {
+            return(true);
+        }
+        else {
+            Prefetch -> Restart(BufferStart + TAPE_FILE_BLOCK);
+        }
+    }
+
+    start = HostTicks();
+    try {
+        fd -> Seek(BufferStart,soFromBeginning);
+        BufferLength = fd -> Read(Buffer,TAPE_FILE_BLOCK);
+    }
+    catch(Exception &e) {
+        DEBUG("TTapeFile::Load: Read failed at %lld",BufferStart);
+        BufferLength = 0;
+        HostDone(start);
+        return(false);
+    }
+    HostDone(start);
+
+    if(BufferLength < 0) {
+        BufferLength = 0;
+    }
+    return(true);
+}
+
+//  SIMH image support.
+
+//  Returns true if the file name says it is a SIMH image
+
+bool TTapeFile::IsSimhFile(String filename) {
+    return(SameText(ExtractFileExt(filename),".tap"));
+}
+
+//  Private method to read a SIMH image and convert it into our format.
+//  The result is never any bigger than the SIMH image (every data byte
+//  becomes one frame, and the 4 byte markers become at most 2 frames).
+//  The caller has already made sure that it isn't too big.
+
+bool TTapeFile::LoadSimh() {
+
+    unsigned char *tap;
+    long length;
+    bool ok = true;
+    __int64 start;
+
+    length = (long) fd -> Size;
+    tap = new unsigned char[length > 0 ? length : 1];
+
+    start = HostTicks();
+    try {
+        fd -> Seek(0,soFromBeginning);
+        if(fd -> Read(tap,length) != length) {
+            ok = false;
+        }
+    }
+    catch(Exception &e) {
+        ok = false;
+    }
+    HostDone(start);
+
+    if(!ok) {
+        DEBUG("TTapeFile::LoadSimh: Read failed");
+        length = 0;
+    }
+
+    Capacity = length + TAPE_FILE_BLOCK;
+    Buffer = new unsigned char[Capacity];
+    Size = BufferLength = FromSimh(tap,length,Buffer);
+    SimhMark = 0;
+    SimhMarkFile = 0;
+    SimhDirty = -1;
+    delete[] tap;
+    return(ok);
+}
+
+//  Private method to write the image back out in SIMH format.  Only the
+//  part from the first changed record on is written: we remember where
+//  the record we started at last time is in both the image and the file
+//  (the mark), and walk forward from there over the records that come
+//  entirely before the first changed frame, adding up how long each one
+//  is in SIMH format.  (A record that ends right where the change starts
+//  is written again anyway, in case the change took away its end, and
+//  a change at or before the mark starts over from the beginning.)  So
+//  a tape being written front to back is only converted once, not over
+//  again from the load point at every tape mark.
+
+bool TTapeFile::WriteSimhImage() {
+
+    bool ok;
+    long pos, end;
+    __int64 start;
+
+    if(SimhDirty < 0) {
+        SimhDirty = 0;
+    }
+    if(SimhDirty <= SimhMark || SimhMark > BufferLength) {
+        SimhMark = 0;
+        SimhMarkFile = 0;
+    }
+
+    for(pos = SimhMark; pos < BufferLength; pos = end) {
+        for(end = pos + 1; end < BufferLength && !(Buffer[end] & TAPE_IRG);
+            ++end)
+            ;
+        if(end >= SimhDirty || end >= BufferLength) {
+            break;
+        }
+        SimhMarkFile += SimhLength(Buffer + pos,end - pos,false);
+    }
+    if(pos > BufferLength) {
+        pos = BufferLength;
+    }
+    SimhMark = pos;
+
+    start = HostTicks();
+    try {
+        fd -> Seek(SimhMarkFile,soFromBeginning);
+        ok = ToSimh(Buffer + pos,BufferLength - pos,fd);
+        fd -> Size = fd -> Position;                //  Truncate the rest
+    }
+    catch(Exception &e) {
+        ok = false;
+    }
+    HostDone(start);
+
+    if(!ok) {
+        DEBUG("TTapeFile::WriteSimhImage: Write failed");
+        SimhMark = 0;                               //  Do it all next time
+        SimhMarkFile = 0;
+    }
+    SimhDirty = -1;
+    DirtyStart = DirtyEnd = 0;
+    return(ok);
+}
+
+//  Private method to work out the SIMH record word for the record of n
+//  frames at image (last is true if it is the last thing in the image).
+
+unsigned long TTapeFile::SimhWord(const unsigned char *image, long n,
+    bool last) {
+
+    if(n == 1 && last && image[0] == TAPE_IRG) {
+        return(TAPE_SIMH_EOM);                      //  Closing IRG
+    }
+    if(n == 2 && (image[0] & ~TAPE_IRG) == TAPE_TM && image[1] == TAPE_TM) {
+        return(TAPE_SIMH_TM);
+    }
+    return((unsigned long) n);
+}
+
+//  And how many bytes that record takes up in a SIMH image.
+
+long TTapeFile::SimhLength(const unsigned char *image, long n, bool last) {
+
+    unsigned long w = SimhWord(image,n,last);
+
+    if(w == TAPE_SIMH_TM || w == TAPE_SIMH_EOM) {
+        return(4);
+    }
+    return(n + (n & 1) + 8);                        //  Length, data, length
+}
+
+//  Convert a SIMH image to our format.  Returns the size of the result.
+//  A bad record length ends the conversion there.
+
+long TTapeFile::FromSimh(const unsigned char *tap, long length,
+    unsigned char *image) {
+
+    unsigned long w;
+    long pos = 0, size = 0, n, i;
+    bool masked = false;
+
+    while(pos + 4 <= length) {
+
+        w = tap[pos] | (tap[pos+1] << 8) | (tap[pos+2] << 16) |
+            ((unsigned long) tap[pos+3] << 24);
+        pos += 4;
+
+        if(w == TAPE_SIMH_TM) {
+            image[size++] = TAPE_TM | TAPE_IRG;
+            image[size++] = TAPE_TM;
+            continue;
+        }
+
+        if(w == TAPE_SIMH_EOM) {
+            image[size++] = TAPE_IRG;               //  Closing IRG
+            break;
+        }
+
+        //  Anything with class bits other than the error flag is an erase
+        //  gap or a private marker or record.  Markers have no data.
+
+        if((w & ~(TAPE_SIMH_ERROR | TAPE_SIMH_LENGTH)) != 0) {
+            if((w >> 28) >= 1 && (w >> 28) <= 6) {
+                n = (long) (w & 0x0fffffffUL);
+                pos += ((n + 1) & ~1L) + 4;
+            }
+            continue;
+        }
+
+        n = (long) (w & TAPE_SIMH_LENGTH);
+        if(n == 0 || pos + n > length) {
+            DEBUG("TTapeFile::FromSimh: Bad record length at %ld",pos - 4);
+            break;
+        }
+
+        for(i=0; i < n; ++i) {
+            if(tap[pos+i] & TAPE_IRG) {
+                masked = true;
+            }
+            image[size++] = (unsigned char) (tap[pos+i] & ~TAPE_IRG);
+        }
+        image[size - n] |= TAPE_IRG;
+
+        pos += ((n + 1) & ~1L) + 4;                 //  Data, pad, length
+    }
+
+    if(masked) {
+        DEBUG("TTapeFile::FromSimh: Data with bit 7 on, ignored");
+    }
+    return(size);
+}
+
+//  Convert an image in our format to SIMH, writing it to out.  Output is
+//  collected in a block, so we don't make a call on the stream for every
+//  little thing.
+
+bool TTapeFile::ToSimh(const unsigned char *image, long size, TStream *out) {
+
+    unsigned char *block;
+    long used = 0, start, end, n, i;
+    unsigned long w;
+    bool ok = true;
+
+    block = new unsigned char[TAPE_FILE_BLOCK];
+
+    for(start = 0; start < size && ok; start = end) {
+
+        for(end = start + 1; end < size && !(image[end] & TAPE_IRG); ++end)
+            ;
+        n = end - start;
+        w = SimhWord(image + start,n,end == size);
+
+        //  Make sure the whole record will fit in the block.  If it won't
+        //  even fit in an empty block, write the data directly.
+
+        if(used + n + 9 > TAPE_FILE_BLOCK) {
+            ok = out -> Write(block,used) == used;
+            used = 0;
+        }
+
+        for(i=0; i < 4; ++i) {
+            block[used++] = (unsigned char) (w >> (8 * i));
+        }
+
+        if(w == TAPE_SIMH_TM || w == TAPE_SIMH_EOM) {
+            continue;
+        }
+
+        if(n + 9 > TAPE_FILE_BLOCK) {
+            block[used++] = image[start] & ~TAPE_IRG;
+            ok = out -> Write(block,used) == used &&
+                out -> Write(image + start + 1,n - 1) == n - 1;
+            used = 0;
+        }
+        else {
+            memcpy(block + used,image + start,n);
+            block[used] &= ~TAPE_IRG;
+            used += n;
+        }
+
+        if(n & 1) {
+            block[used++] = 0;                      //  Pad to even length
+        }
+        for(i=0; i < 4; ++i) {
+            block[used++] = (unsigned char) (w >> (8 * i));
+        }
+    }
+
+    if(ok && used > 0) {
+        ok = out -> Write(block,used) == used;
+    }
+    delete[] block;
+    return(ok);
+}
+
+//  Copy a tape image, converting it from one format to the other (or not)
+//  depending upon the file names.  Returns false if it didn't work.
+
+bool TTapeFile::Convert(String from, String to) {
+
+    TTapeFile *in;
+    TFileStream *out;
+    unsigned char *image;
+    __int64 length;
+    long size;
+    bool ok;
+
+    try {
+        in = new TTapeFile(from,true);
+    }
+    catch(EFOpenError &e) {
+        DEBUG("TTapeFile::Convert: Cannot open %s",AnsiString(from).c_str());
+        return(false);
+    }
+
+    //  The whole image is converted in memory, so it has to fit.
+
+    length = in -> GetSize();
+    if(length > TAPE_SIMH_MAX) {
+        DEBUG("TTapeFile::Convert: %s is too big",
+            AnsiString(ExtractFileName(from)).c_str());
+        delete in;
+        return(false);
+    }
+
+    size = (long) length;
+    image = new unsigned char[size > 0 ? size : 1];
+    ok = in -> Read(image,size) == size;
+    delete in;
+
+    try {
+        out = new TFileStream(to,fmCreate);
+    }
+    catch(Exception &e) {
+        DEBUG("TTapeFile::Convert: Cannot create %s",AnsiString(to).c_str());
+        delete[] image;
+        return(false);
+    }
+
+    try {
+        if(ok && IsSimhFile(to)) {
+            ok = ToSimh(image,size,out);
+        }
+        else if(ok) {
+            ok = out -> Write(image,size) == size;
+        }
+    }
+    catch(Exception &e) {
+        ok = false;
+    }
+
+    delete out;
+    delete[] image;
+
+    DEBUG("TTapeFile::Convert: %s to %s %s",AnsiString(from).c_str(),
+        AnsiString(to).c_str(),ok ? "done" : "FAILED");
+    return(ok);
+}
@@ -0,0 +1,222 @@
+//---------------------------------------------------------------------------
+#ifndef UITAPEFILEH
+#define UITAPEFILEH
+//---------------------------------------------------------------------------
+#include <System.SyncObjs.hpp>
+//---------------------------------------------------------------------------
+
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//  Buffered tape image file.  The tape unit reads and writes its image
+//  one frame at a time, and backs up over frames a lot.  Doing that
+//  directly on a TFileStream costs a system call per frame.  This class
+//  looks like just enough of a TFileStream for the tape unit, but keeps a
+//  block of the file in memory.  Reads come out of the block (read
+//  ahead), writes go into it (write behind), and seeks just move the
+//  position.  The block only goes back out to the file when we have to
+//  move to a different block, or when the tape unit asks for a Flush
+//  (tape mark, rewind, unload).
+//
+//  The tape unit only ever hands us whole records, so a block that goes
+//  out to the file only ever has whole records in it.  A record that
+//  would not fit in the rest of the block goes straight out to the file
+//  in one piece instead, so that it, too, can not be left half written.
+//  Sync() flushes and then asks Windows to get it all onto the disk.
+//
+//  Tapes mounted file protected (input masters, mostly) can never be
+//  written, so for those we map the whole image into memory instead, and
+//  the "block" is simply the whole file.  The mapping is shared: if
+//  several drives mount the same image, they all use the same view (and
+//  Windows shares the pages with any other process that maps the file).
+//  If the image can't be mapped (say it is empty, or too big for the
+//  address space) we just fall back to the buffered file.
+
+#define TAPE_FILE_BLOCK     65536                   //  Block size, bytes
+
+//  SIMH tape images (.tap).  Our own image format marks the first frame
+//  of each record with the IRG bit, and writes a tape mark as a record of
+//  two tape mark characters.  SIMH images instead have a 4 byte little
+//  endian record length before and after each record (padded to an even
+//  length), a length of 0 for a tape mark, and all ones for end of
+//  medium.  Other emulators read and write SIMH images.
+//
+//  The tape unit only knows about our own format, so a SIMH image is
+//  converted to our format in memory when it is opened, and converted
+//  back when it is flushed.  Conversion in both directions is lossless:
+//
+//      Our format                          SIMH
+//      ----------------------------------  ------------------------------
+//      Record (IRG bit on first frame)     Record (length, data, length)
+//      Record of two tape mark chars       Tape mark (length 0)
+//      Closing IRG frame at end of image   End of medium
+//
+//  (SIMH error flags, erase gaps and private markers have no equivalent
+//  in our format, and are dropped when a SIMH image is read.)
+
+#define TAPE_SIMH_TM        0x00000000UL            //  SIMH tape mark
+#define TAPE_SIMH_EOM       0xffffffffUL            //  SIMH end of medium
+#define TAPE_SIMH_GAP       0xfffeffffUL            //  SIMH erase gap
+#define TAPE_SIMH_HALFGAP   0xfffffffeUL            //  Half an erase gap
+#define TAPE_SIMH_ERROR     0x80000000UL            //  Bad record flag
+#define TAPE_SIMH_LENGTH    0x00ffffffUL            //  Record length mask
+
+//  A SIMH image is held in memory, in one buffer, so it can't be bigger
+//  than this (a bit under 2 GB).  Bigger images fail to open.
+
+#define TAPE_SIMH_MAX       0x7ff00000L             //  Biggest image
+
+//  Read ahead thread.  A tape that is mounted read/write (so it is not
+//  mapped) is still mostly read front to back.  Each such tape gets a
+//  thread that reads the blocks after the current one into a ring, so
+//  that by the time the tape unit gets to the end of a block, the next one
+//  is (usually) already in memory, and channel input does not have to
+//  wait on the disk.
+//
+//  The ring has exactly one producer (the thread) and one consumer (the
+//  tape file, on the CPU thread), so it needs no locks: the thread only
+//  moves Head, and the consumer only moves Tail.  When the consumer wants
+//  the thread to start over somewhere else (a backspace, or a rewind) it
+//  sets RequestStart and bumps Generation.  The thread then starts reading
+//  there, and the consumer throws away any blocks left over from an older
+//  generation.  Writing stops the thread until the next read miss, since
+//  blocks read ahead of a write might not be current any more.
+
+#define TAPE_PREFETCH_BLOCKS    4                   //  Blocks in the ring
+
+struct TTapePrefetchBlock {
+    __int64 Start;                                  //  File offset
+    long Length;                                    //  Bytes read
+    long Generation;                                //  Request it was for
+    unsigned char Data[TAPE_FILE_BLOCK];
+};
+
+class TTapePrefetch : public TThread {
+
+private:
+
+    TFileStream *fd;                                //  Our own handle
+    TEvent *Wake;                                   //  Wake the thread up
+    TTapePrefetchBlock *Ring;
+    volatile long Head;                             //  Next block to fill
+    volatile long Tail;                             //  Next block to use
+    volatile long Generation;                       //  Current request
+    volatile __int64 RequestStart;                  //  Where to read next
+
+protected:
+
+    void __fastcall Execute();
+
+public:
+
+    long Hits, Misses;                              //  Statistics
+
+    __fastcall TTapePrefetch(String filename);      //  Throws EFOpenError
+    __fastcall ~TTapePrefetch();
+
+    bool Get(__int64 start, unsigned char *buf, long &length);
+    void Restart(__int64 start);                    //  Read ahead from start
+    void Stop();                                    //  Stop reading ahead
+};
+
+//  A shared read-only mapping of a tape image.
+
+class TTapeMapping {
+
+private:
+
+    static TTapeMapping *FirstMapping;              //  List of mappings
+
+    TTapeMapping *NextMapping;
+    String FileName;                                //  Full path name
+    HANDLE File;                                    //  Windows file handle
+    HANDLE Mapping;                                 //  File mapping object
+    int Users;                                      //  Reference count
+
+    TTapeMapping(String filename);
+
+public:
+
+    unsigned char *View;                            //  The image itself
+    __int64 Size;                                   //  Its size
+
+    static TTapeMapping *Open(String filename);     //  NULL if can't map
+    void Close();                                   //  Done with mapping
+};
+
+class TTapeFile : public TObject {
+
+private:
+
+    TFileStream *fd;                                //  Underlying file
+    TTapeMapping *Map;                              //  Or mapping, if RO
+    TTapePrefetch *Prefetch;                        //  Read ahead, if any
+    bool Simh;                                      //  True if SIMH image
+    long Capacity;                                  //  Buffer size if SIMH
+    unsigned char *Buffer;                          //  Current block
+    __int64 BufferStart;                            //  File offset of block
+    long BufferLength;                              //  Valid bytes in block
+    long DirtyStart, DirtyEnd;                      //  Modified part, if any
+    long SimhMark;                                  //  SIMH: record start
+    __int64 SimhMarkFile;                           //  and where it is in .tap
+    long SimhDirty;                                 //  First change, or -1
+    __int64 Pos;                                    //  Current position
+    __int64 Size;                                   //  Current file size
+    long HostCalls;                                 //  File I/O calls made
+    __int64 HostTime;                               //  and time in them
+
+    static __int64 HostTicks();                     //  Performance counter
+    void HostDone(__int64 start);                   //  Count a file I/O call
+
+    bool Load(__int64 pos, bool reading);           //  Get block for pos
+    bool LoadSimh();                                //  Read SIMH image
+    bool WriteSimhImage();                          //  Write it back out
+
+    static long FromSimh(const unsigned char *tap, long length,
+        unsigned char *image);
+    static bool ToSimh(const unsigned char *image, long size, TStream *out);
+    static unsigned long SimhWord(const unsigned char *image, long n,
+        bool last);
+    static long SimhLength(const unsigned char *image, long n, bool last);
+
+public:
+
+    TTapeFile(String filename, bool readonly);      //  Throws EFOpenError
+    ~TTapeFile();
+
+    int Read(void *buf, int count);
+    int Write(const void *buf, int count);
+    __int64 Seek(__int64 offset, unsigned short origin);
+    bool Flush();                                   //  Write behind data out
+    bool Sync();                                    //  Flush, and to disk
+    bool Truncate(__int64 size);                    //  Cut off the end
+
+    inline __int64 GetPosition() { return Pos; }
+    inline __int64 GetSize() { return Size; }
+    inline bool IsMapped() { return Map != NULL; }
+    inline bool IsSimh() { return Simh; }
+    inline long GetHostCalls() { return HostCalls; }
+    __int64 GetHostMicroseconds();
+
+    static bool ReadAhead;                          //  Use read ahead thread
+
+    static bool IsSimhFile(String filename);        //  True if .tap
+    static bool Convert(String from, String to);    //  Copy, changing format
+};
+
+#endif
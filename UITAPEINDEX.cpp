@@ -0,0 +1,315 @@
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UITAPEFILE.h"
+#include "UITAPEUNIT.h"
+#include "UITAPEINDEX.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+
+//  Tape Index Implementation
+
+//  Chunk size used when we scan the image ourselves.
+
+#define TAPE_INDEX_SCAN     4096
+
+TTapeIndex::TTapeIndex() {
+    Records = NULL;
+    Capacity = 0;
+    Clear();
+}
+
+TTapeIndex::~TTapeIndex() {
+    delete[] Records;
+}
+
+//  Forget everything.  (Keeps the storage, though.)
+
+void TTapeIndex::Clear() {
+    Count = 0;
+    IndexedTo = 0;
+    Changed = false;
+}
+
+//  Private method to add a record start at the end of the index.
+
+void TTapeIndex::Add(__int64 offset, bool tapemark) {
+
+    TTapeRecord *r;
+
+    if(Count >= Capacity) {
+        Capacity = (Capacity == 0) ? 1024 : 2 * Capacity;
+        r = new TTapeRecord[Capacity];
+        if(Count > 0) {
+            memcpy(r,Records,Count * sizeof(TTapeRecord));
+        }
+        delete[] Records;
+        Records = r;
+    }
+
+    Records[Count].Offset = offset;
+    Records[Count].TapeMark = tapemark;
+    ++Count;
+}
+
+//  The tape unit calls this for every frame it reads or writes.  If it is
+//  the next frame we have not seen yet, we can extend the index by one.
+//  (Frames we have already seen are already in there, and frames past the
+//  end of the index will get picked up by a scan later.)
+
+void TTapeIndex::Frame(__int64 pos, int c) {
+
+    if(pos != IndexedTo) {
+        return;
+    }
+    if(c & TAPE_IRG) {
+        Add(pos,(c & 0x3f) == TAPE_TM);
+    }
+    ++IndexedTo;
+    Changed = true;
+}
+
+//  The image is about to change at pos.  Anything we know from there on
+//  is no longer any good.
+
+void TTapeIndex::Invalidate(__int64 pos) {
+
+    if(pos >= IndexedTo) {
+        return;
+    }
+    while(Count > 0 && Records[Count-1].Offset >= pos) {
+        --Count;
+    }
+    IndexedTo = pos;
+    Changed = true;
+}
+
+//  Private method to scan the image past the end of the index.  If next is
+//  false, scans until the index covers pos.  If next is true, scans until
+//  we find a record starting at or after pos.  Either way, stops at end of
+//  file.  The file position is left where it was.  Returns false on an
+//  I/O error.
+
+bool TTapeIndex::Scan(TTapeFile *fd, __int64 pos, bool next) {
+
+    unsigned char chunk[TAPE_INDEX_SCAN];
+    __int64 save;
+    int n, i;
+
+    save = fd -> GetPosition();
+    fd -> Seek(IndexedTo,soFromBeginning);
+
+    while(IndexedTo < fd -> GetSize()) {
+        if(!next && IndexedTo > pos) {
+            break;
+        }
+        if(next && Count > 0 && Records[Count-1].Offset >= pos) {
+            break;
+        }
+        if((n = fd -> Read(chunk,TAPE_INDEX_SCAN)) <= 0) {
+            DEBUG("TTapeIndex::Scan: Read failed at %lld",IndexedTo);
+            fd -> Seek(save,soFromBeginning);
+            return(false);
+        }
+        for(i=0; i < n; ++i) {
+            Frame(IndexedTo,chunk[i]);
+        }
+    }
+
+    fd -> Seek(save,soFromBeginning);
+    return(true);
+}
+
+//  Private method: binary search for the last record starting at or
+//  before pos.  Returns -1 if there isn't one.
+
+int TTapeIndex::Search(__int64 pos) {
+
+    int lo = 0, hi = Count - 1, mid, found = -1;
+
+    while(lo <= hi) {
+        mid = (lo + hi) / 2;
+        if(Records[mid].Offset <= pos) {
+            found = mid;
+            lo = mid + 1;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    return(found);
+}
+
+//  Return the number of the last record that starts at or before pos, or
+//  -1 if there is no such record (or we could not find out).
+
+int TTapeIndex::Last(TTapeFile *fd, __int64 pos) {
+
+    if(pos >= IndexedTo && !Scan(fd,pos,false)) {
+        return(-1);
+    }
+    return(Search(pos));
+}
+
+//  Return the number of the first record that starts at or after pos, or
+//  -1 if there isn't one before the end of the image.
+
+int TTapeIndex::Next(TTapeFile *fd, __int64 pos) {
+
+    int n;
+
+    if((Count == 0 || Records[Count-1].Offset < pos) && !Scan(fd,pos,true)) {
+        return(-1);
+    }
+    n = Search(pos - 1) + 1;
+    return(n < Count ? n : -1);
+}
+
+//  Sidecar file methods.  The file holds the magic string, the size and
+//  time stamp of the image, how far the index goes, the count, and then
+//  the record offsets.  A tape mark is flagged in the low bit of each
+//  offset (the offset is shifted left one).
+
+String TTapeIndex::IndexFileName(String filename) {
+    return(filename + ".idx");
+}
+
+bool TTapeIndex::Load(String filename, __int64 size) {
+
+    TFileStream *f;
+    char magic[8];
+    __int64 savedsize, indexedto, *buf;
+    TDateTime age;
+    double savedage;
+    int count, i;
+    bool ok;
+
+    Clear();
+
+    if(!FileExists(IndexFileName(filename)) || !FileAge(filename,age)) {
+        return(false);
+    }
+
+    try {
+        f = new TFileStream(IndexFileName(filename),fmOpenRead);
+    }
+    catch(Exception &e) {
+        return(false);
+    }
+
+    ok = f -> Read(magic,sizeof(magic)) == sizeof(magic) &&
+        memcmp(magic,TAPE_INDEX_MAGIC,sizeof(magic)) == 0 &&
+        f -> Read(&savedsize,sizeof(savedsize)) == sizeof(savedsize) &&
+        f -> Read(&savedage,sizeof(savedage)) == sizeof(savedage) &&
+        f -> Read(&indexedto,sizeof(indexedto)) == sizeof(indexedto) &&
+        f -> Read(&count,sizeof(count)) == sizeof(count) &&
+        savedsize == size && savedage == (double) age &&
+        indexedto <= size && count >= 0 && count <= indexedto;
+
+    if(!ok) {
+        DEBUG("TTapeIndex::Load: Index for %s is out of date",
+            AnsiString(filename).c_str());
+        delete f;
+        return(false);
+    }
+
+    buf = new __int64[count > 0 ? count : 1];
+    if(f -> Read(buf,count * sizeof(__int64)) !=
+       (int) (count * sizeof(__int64))) {
+        delete[] buf;
+        delete f;
+        return(false);
+    }
+    delete f;
+
+    for(i=0; i < count; ++i) {
+        Add(buf[i] >> 1,(buf[i] & 1) != 0);
+    }
+    delete[] buf;
+    IndexedTo = indexedto;
+    Changed = false;
+
+    DEBUG("TTapeIndex::Load: %d records for %s",count,
+        AnsiString(filename).c_str());
+    return(true);
+}
+
+//  Save the index, if it has changed.  The image must already be closed
+//  so that it has its final size and time stamp.
+
+bool TTapeIndex::Save(String filename, __int64 size) {
+
+    TFileStream *f;
+    __int64 *buf;
+    TDateTime age;
+    double savedage;
+    int i;
+    bool ok;
+
+    if(!Changed || IndexedTo == 0 || !FileAge(filename,age)) {
+        return(true);
+    }
+
+    savedage = (double) age;
+    buf = new __int64[Count > 0 ? Count : 1];
+    for(i=0; i < Count; ++i) {
+        buf[i] = (Records[i].Offset << 1) | (Records[i].TapeMark ? 1 : 0);
+    }
+
+    try {
+        f = new TFileStream(IndexFileName(filename),fmCreate);
+    }
+    catch(Exception &e) {
+        DEBUG("TTapeIndex::Save: Cannot create index for %s",
+            AnsiString(filename).c_str());
+        delete[] buf;
+        return(false);
+    }
+
+    ok = f -> Write(TAPE_INDEX_MAGIC,8) == 8 &&
+        f -> Write(&size,sizeof(size)) == sizeof(size) &&
+        f -> Write(&savedage,sizeof(savedage)) == sizeof(savedage) &&
+        f -> Write(&IndexedTo,sizeof(IndexedTo)) == sizeof(IndexedTo) &&
+        f -> Write(&Count,sizeof(Count)) == sizeof(Count) &&
+        f -> Write(buf,Count * sizeof(__int64)) ==
+            (int) (Count * sizeof(__int64));
+
+    delete f;
+    delete[] buf;
+
+    if(!ok) {
+        DEBUG("TTapeIndex::Save: Write failed for index for %s",
+            AnsiString(filename).c_str());
+        return(false);
+    }
+
+    Changed = false;
+    return(true);
+}
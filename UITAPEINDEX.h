@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------
+#ifndef UITAPEINDEXH
+#define UITAPEINDEXH
+//---------------------------------------------------------------------------
+
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//  Tape record index.  On the tape image, the first frame of every
+//  record has the IRG bit on, and that is the only way to find a record.
+//  Spacing forward means reading every frame of the record, and backing
+//  up means stepping back one frame at a time, looking for the bit.
+//  Sort programs backspace and re-read a lot, so this class remembers
+//  where each record starts (and whether it is a tape mark).
+//
+//  The index is only good for the part of the image we have seen so far
+//  (everything below IndexedTo).  The tape unit tells us about every
+//  frame it reads or writes, so ordinary sequential work builds the index
+//  for free.  When the tape unit needs to look further ahead than that,
+//  we scan the image ourselves.  A write throws away everything from the
+//  write position on, because a write does not erase what was on the
+//  tape beyond it, and the new data may not line up with the old.
+//
+//  The index can be kept in a file next to the tape image (the image name
+//  with .idx tacked on), so that it survives unload and remount.  It is
+//  only used if the image has the same size and time stamp as when the
+//  index was saved - otherwise we just start over.
+
+#define TAPE_INDEX_MAGIC    "1410TIX1"
+
+class TTapeFile;
+
+struct TTapeRecord {
+    __int64 Offset;                                 //  Offset of IRG frame
+    bool TapeMark;                                  //  True if a tape mark
+};
+
+class TTapeIndex : public TObject {
+
+private:
+
+    TTapeRecord *Records;                           //  Record starts, in order
+    int Count;                                      //  Entries in use
+    int Capacity;                                   //  Entries allocated
+    __int64 IndexedTo;                              //  Index good below this
+    bool Changed;                                   //  Needs to be saved
+
+    void Add(__int64 offset, bool tapemark);
+    bool Scan(TTapeFile *fd, __int64 pos, bool next);
+    int Search(__int64 pos);                        //  Last start <= pos
+    static String IndexFileName(String filename);
+
+public:
+
+    TTapeIndex();
+    ~TTapeIndex();
+
+    void Clear();                                   //  Forget everything
+    void Frame(__int64 pos, int c);                 //  Frame read/written
+    void Invalidate(__int64 pos);                   //  Image changed at pos
+
+    int Last(TTapeFile *fd, __int64 pos);           //  Last record <= pos
+    int Next(TTapeFile *fd, __int64 pos);           //  First record >= pos
+
+    inline int GetCount() { return Count; }
+    inline __int64 GetOffset(int n) { return Records[n].Offset; }
+    inline bool IsTapeMark(int n) { return Records[n].TapeMark; }
+    inline __int64 GetIndexedTo() { return IndexedTo; }
+
+    //  Sidecar file
+
+    bool Load(String filename, __int64 size);
+    bool Save(String filename, __int64 size);
+};
+
+#endif
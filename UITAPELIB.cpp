@@ -0,0 +1,314 @@
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <stdio.h>
+#include <assert.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UIHOPPER.h"
+#include "UI1410CHANNEL.h"
+#include "UITAPEUNIT.h"
+#include "UITAPETAU.h"
+#include "UITAPELIB.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+
+//  Tape Library Implementation
+
+TTapeVolume *TTapeLibrary::FirstVolume = NULL;
+TTapeMount TTapeLibrary::Plan[TAPE_LIB_MAXPLAN];
+int TTapeLibrary::PlanCount = 0;
+TTapeTAU *TTapeLibrary::TAU[MAXCHANNEL];
+TTapeVolume *TTapeLibrary::OnDrive[MAXCHANNEL][TAPE_LIB_UNITS];
+long TTapeLibrary::StartRead[MAXCHANNEL][TAPE_LIB_UNITS];
+long TTapeLibrary::StartWritten[MAXCHANNEL][TAPE_LIB_UNITS];
+__int64 TTapeLibrary::StartTime[MAXCHANNEL][TAPE_LIB_UNITS];
+
+TTapeVolume::TTapeVolume(String volser, String filename) {
+    NextVolume = NULL;
+    Volser = volser;
+    FileName = filename;
+    Mounts = 0;
+    RecordsRead = RecordsWritten = 0;
+    MountedCycles = 0;
+}
+
+//  Tell the library where the tape drives are (called as the TAUs are
+//  handed to the 729 panel)
+
+void TTapeLibrary::SetTAU(TTapeTAU *tau, int ch) {
+    assert(ch >= 0 && ch < MAXCHANNEL);
+    TAU[ch] = tau;
+}
+
+//  Forget the catalog and the plan.  (Tapes already mounted stay mounted,
+//  of course.)
+
+void TTapeLibrary::Clear() {
+
+    TTapeVolume *v;
+    int ch, u;
+
+    while((v = FirstVolume) != NULL) {
+        FirstVolume = v -> NextVolume;
+        delete v;
+    }
+    PlanCount = 0;
+
+    for(ch=0; ch < MAXCHANNEL; ++ch) {
+        for(u=0; u < TAPE_LIB_UNITS; ++u) {
+            OnDrive[ch][u] = NULL;
+        }
+    }
+}
+
+//  Find a volume in the catalog.  NULL if it isn't there.
+
+TTapeVolume *TTapeLibrary::Find(String volser) {
+
+    TTapeVolume *v;
+
+    for(v = FirstVolume; v != NULL; v = v -> NextVolume) {
+        if(SameText(v -> Volser,volser)) {
+            return(v);
+        }
+    }
+    return(NULL);
+}
+
+//  Load a library file.  Replaces any catalog and plan we had, and then
+//  mounts the first planned volume on each drive that is empty.  Returns
+//  false if the file could not be read, or had errors in it (the good
+//  lines are still used).
+
+bool TTapeLibrary::Load(String filename) {
+
+    TStringList *lines;
+    TTapeVolume *v, **last;
+    String line, word[4];
+    int i, n, p, ch, u;
+    bool ok = true;
+
+    lines = new TStringList();
+    try {
+        lines -> LoadFromFile(filename);
+    }
+    catch(Exception &e) {
+        DEBUG("Tape library: cannot read %s",AnsiString(filename).c_str());
+        delete lines;
+        return(false);
+    }
+
+    Clear();
+    last = &FirstVolume;
+
+    for(i=0; i < lines -> Count; ++i) {
+
+        //  Split the line into (up to) 4 words.  The last one gets the
+        //  rest of the line, so a path can have blanks in it.
+
+        line = StringReplace(lines -> Strings[i],"\t"," ",
+            TReplaceFlags() << rfReplaceAll).Trim();
+        if(line.Length() == 0 || line[1] == '*' || line[1] == ';') {
+            continue;
+        }
+        for(n=0; n < 4 && line.Length() > 0; ++n) {
+            p = line.Pos(" ");
+            if(p == 0 || n == 3 ||
+               (n == 2 && SameText(word[0],"VOLUME"))) {
+                word[n] = line;
+                line = "";
+            }
+            else {
+                word[n] = line.SubString(1,p-1);
+                line = line.SubString(p+1,line.Length()).Trim();
+            }
+        }
+
+        if(SameText(word[0],"VOLUME") && n == 3) {
+            if(Find(word[1]) != NULL) {
+                DEBUG("Tape library: line %d: duplicate volume %s",i+1,
+                    AnsiString(word[1]).c_str());
+                ok = false;
+                continue;
+            }
+            v = new TTapeVolume(word[1],word[2]);
+            *last = v;
+            last = &(v -> NextVolume);
+        }
+        else if(SameText(word[0],"MOUNT") && n == 4) {
+            ch = StrToIntDef(word[1],0) - 1;
+            u = StrToIntDef(word[2],-1);
+            v = Find(word[3]);
+            if(ch < 0 || ch >= MAXCHANNEL || TAU[ch] == NULL ||
+               u < 0 || u >= TAPE_LIB_UNITS || v == NULL ||
+               PlanCount >= TAPE_LIB_MAXPLAN) {
+                DEBUG("Tape library: line %d: bad mount",i+1);
+                ok = false;
+                continue;
+            }
+            Plan[PlanCount].Channel = ch;
+            Plan[PlanCount].Unit = u;
+            Plan[PlanCount].Volume = v;
+            Plan[PlanCount].Done = false;
+            ++PlanCount;
+        }
+        else {
+            DEBUG("Tape library: line %d: not understood",i+1);
+            ok = false;
+        }
+    }
+
+    delete lines;
+
+    //  Mount the first volume on every empty drive that has one planned.
+
+    for(ch=0; ch < MAXCHANNEL; ++ch) {
+        for(u=0; u < TAPE_LIB_UNITS; ++u) {
+            if(TAU[ch] != NULL && !TAU[ch] -> GetUnit(u) -> IsLoaded()) {
+                MountNext(ch,u);
+            }
+        }
+    }
+
+    return(ok);
+}
+
+//  Private method to mount the next volume planned for a drive, load it
+//  and make it ready.  Returns false if there was nothing more to mount
+//  (or it wouldn't mount).
+
+bool TTapeLibrary::MountNext(int ch, int unit) {
+
+    TTapeUnit *t = TAU[ch] -> GetUnit(unit);
+    TTapeVolume *v;
+    int i;
+
+    for(i=0; i < PlanCount; ++i) {
+        if(!Plan[i].Done && Plan[i].Channel == ch && Plan[i].Unit == unit) {
+            break;
+        }
+    }
+    if(i >= PlanCount) {
+        return(false);
+    }
+
+    Plan[i].Done = true;
+    v = Plan[i].Volume;
+
+    if(!t -> Mount(v -> FileName) || !t -> LoadRewind() || !t -> Start()) {
+        DEBUG("Tape library: unable to mount %s on channel %d unit %d",
+            AnsiString(v -> Volser).c_str(),ch+1,unit);
+        return(false);
+    }
+
+    DEBUG("Tape library: mounted %s on channel %d unit %d",
+        AnsiString(v -> Volser).c_str(),ch+1,unit);
+
+    ++(v -> Mounts);
+    OnDrive[ch][unit] = v;
+    StartRead[ch][unit] = t -> GetRecordsRead();
+    StartWritten[ch][unit] = t -> GetRecordsWritten();
+    StartTime[ch][unit] = TVirtualClock::Now();
+    return(true);
+}
+
+//  Private method to add what happened on a drive since the last time
+//  to the statistics of the volume on it.
+
+void TTapeLibrary::Account(int ch, int unit) {
+
+    TTapeUnit *t = TAU[ch] -> GetUnit(unit);
+    TTapeVolume *v = OnDrive[ch][unit];
+
+    if(v == NULL) {
+        return;
+    }
+
+    v -> RecordsRead += t -> GetRecordsRead() - StartRead[ch][unit];
+    v -> RecordsWritten += t -> GetRecordsWritten() - StartWritten[ch][unit];
+    v -> MountedCycles += TVirtualClock::Now() - StartTime[ch][unit];
+
+    StartRead[ch][unit] = t -> GetRecordsRead();
+    StartWritten[ch][unit] = t -> GetRecordsWritten();
+    StartTime[ch][unit] = TVirtualClock::Now();
+}
+
+//  Called by the TAU when a program has done a rewind and unload.  Does
+//  the bookkeeping for the old volume, then puts up the next one.
+
+void TTapeLibrary::Unloaded(TTapeTAU *tau, int unit) {
+
+    int ch;
+
+    for(ch=0; ch < MAXCHANNEL && TAU[ch] != tau; ++ch)
+        ;
+    if(ch >= MAXCHANNEL || unit < 0 || unit >= TAPE_LIB_UNITS) {
+        return;
+    }
+
+    Account(ch,unit);
+    OnDrive[ch][unit] = NULL;
+    MountNext(ch,unit);
+}
+
+//  Statistics for the job report
+
+void TTapeLibrary::Report() {
+
+    TTapeVolume *v;
+    int ch, u, pending = 0;
+
+    if(FirstVolume == NULL) {
+        return;
+    }
+
+    for(ch=0; ch < MAXCHANNEL; ++ch) {
+        for(u=0; u < TAPE_LIB_UNITS; ++u) {
+            if(TAU[ch] != NULL) {
+                Account(ch,u);
+            }
+        }
+    }
+
+    for(v = FirstVolume; v != NULL; v = v -> NextVolume) {
+        if(v -> Mounts == 0) {
+            continue;
+        }
+        DEBUG("  Volume %s: %d mounts, %ld records read, %ld written, "
+            "%.3f sec on a drive",AnsiString(v -> Volser).c_str(),
+            v -> Mounts,v -> RecordsRead,v -> RecordsWritten,
+            TVirtualClock::Seconds(v -> MountedCycles));
+    }
+
+    for(u=0; u < PlanCount; ++u) {
+        if(!Plan[u].Done) {
+            ++pending;
+        }
+    }
+    if(pending != 0) {
+        DEBUG("  Tape library: %d planned mounts not done",pending);
+    }
+}
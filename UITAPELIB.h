@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------
+#ifndef UITAPELIBH
+#define UITAPELIBH
+//---------------------------------------------------------------------------
+
+/*
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//  Tape library.  Instead of an operator mounting each reel by hand from
+//  the 729 panel, a library file can give a catalog of volumes (a volume
+//  serial and the image file it lives in) and a mount plan (which volumes
+//  go on which drive, in what order).  The library mounts the first
+//  volume planned for each drive when the file is loaded, and whenever a
+//  program does a rewind and unload, it mounts the next volume planned
+//  for that drive, loads and rewinds it, and presses start - so a multi
+//  reel job can run without anyone watching it.
+//
+//  The library file is plain text, one entry per line:
+//
+//      VOLUME  volser  path            Catalog entry
+//      MOUNT   channel unit volser     Next mount on that drive
+//
+//  Blank lines and lines starting with * or ; are ignored.  The MOUNT
+//  lines for each drive are used in the order they appear.
+//
+//  The library also keeps some statistics for each volume, which are
+//  shown in the job report.
+
+#define TAPE_LIB_MAXPLAN    256                     //  Mounts in a plan
+#define TAPE_LIB_UNITS      10                      //  Drives per channel
+
+class TTapeTAU;
+
+class TTapeVolume {
+
+public:
+
+    TTapeVolume *NextVolume;                        //  Catalog list
+    String Volser;                                  //  Volume serial
+    String FileName;                                //  Tape image
+
+    int Mounts;                                     //  Statistics
+    long RecordsRead;
+    long RecordsWritten;
+    __int64 MountedCycles;                          //  Time on a drive
+
+    TTapeVolume(String volser, String filename);
+};
+
+struct TTapeMount {
+    int Channel;                                    //  Drive
+    int Unit;
+    TTapeVolume *Volume;                            //  What goes on it
+    bool Done;                                      //  True once mounted
+};
+
+class TTapeLibrary {
+
+private:
+
+    static TTapeVolume *FirstVolume;                //  Catalog
+    static TTapeMount Plan[TAPE_LIB_MAXPLAN];       //  Mount plan
+    static int PlanCount;
+    static TTapeTAU *TAU[MAXCHANNEL];
+
+    //  What is on each drive, and its counters when it was mounted
+
+    static TTapeVolume *OnDrive[MAXCHANNEL][TAPE_LIB_UNITS];
+    static long StartRead[MAXCHANNEL][TAPE_LIB_UNITS];
+    static long StartWritten[MAXCHANNEL][TAPE_LIB_UNITS];
+    static __int64 StartTime[MAXCHANNEL][TAPE_LIB_UNITS];
+
+    static void Account(int ch, int unit);          //  Update statistics
+    static bool MountNext(int ch, int unit);        //  Mount next planned
+
+public:
+
+    static void SetTAU(TTapeTAU *tau, int ch);
+    static void Clear();                            //  Forget it all
+    static bool Load(String filename);              //  Read library file
+    static TTapeVolume *Find(String volser);
+    static void Unloaded(TTapeTAU *tau, int unit);  //  Rewind unload done
+    static void Report();                           //  For job report
+};
+
+#endif
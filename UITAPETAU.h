@@ -1,76 +1,130 @@
-//---------------------------------------------------------------------------
-#ifndef UITAPETAUH
-#define UITAPETAUH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-#define TAPE_IO_DEVICE  20
-
-#define UNIT_BACKSPACE  50
-#define UNIT_SKIP       53
-#define UNIT_REWIND     41
-#define UNIT_REWIND_UNLOAD     20
-#define UNIT_WTM        36
-#define UNIT_SPACE      49
-
-//  1410 Tape Adapter Unit
-
-class TTapeTAU : public T1410IODevice {
-
-protected:
-
-    TTapeUnit *Unit[10];                            //  Units 0 thru 9
-    TTapeUnit *TapeUnit;                            //  Current selected unit
-
-    int tapestatus;                                 //  Channel status
-    BCD ch_char;                                    //  Channel character
-
-    char tape_char;                                 //  Tape Unit character
-    int tape_read_char;                             //  Before checking status
-
-    long chars_transferred;                         //  Storage characters
-    char *tape_parity_table;
-
-
-public:
-
-    //  Implement the I/O device interface standard
-
-    TTapeTAU(int devicenum, T1410Channel *Channel);
-    virtual int Select();
-    virtual void DoOutput();
-    virtual void DoInput();
-    virtual int StatusSample();
-    virtual void DoUnitControl(BCD opmod);
-
-    //  State and status methods
-
-    TTapeUnit *GetUnit(int unit);
-
-private:
-
-    //  Internal methods.
-
-    bool DoOutputWrite(char c);
-    int DoInputRead();
-};
-
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UITAPETAUH
+#define UITAPETAUH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define TAPE_IO_DEVICE  20
+
+#define UNIT_BACKSPACE  50
+#define UNIT_SKIP       53
+#define UNIT_REWIND     41
+#define UNIT_REWIND_UNLOAD     20
+#define UNIT_WTM        36
+#define UNIT_SPACE      49
+
+//  While a program spaces, backspaces or skips over a run of records on
+//  the same drive, the tape panel is only repainted this often.
+
+#define TAPE_RUN_DISPLAY_MS 250
+
+//  Flag in tape_read_table for a frame with the wrong parity
+
+#define TAPE_READ_CHECK 0x100
+
+//  TAU statistics (see also TTapeStats, for each drive)
+
+struct TTapeTAUStats {
+    long Selects;
+    long BusySelects;                               //  Found drive busy
+    long ReadOps;
+    long WriteOps;
+    long ControlOps;                                //  Unit control
+    __int64 Characters;                             //  Read and written
+};
+
+//  1410 Tape Adapter Unit
+
+class TTapeTAU : public T1410IODevice {
+
+protected:
+
+    TTapeUnit *Unit[10];                            //  Units 0 thru 9
+    TTapeUnit *TapeUnit;                            //  Current selected unit
+
+    int tapestatus;                                 //  Channel status
+    BCD ch_char;                                    //  Channel character
+
+    char tape_char;                                 //  Tape Unit character
+    int tape_read_char;                             //  Before checking status
+
+    long chars_transferred;                         //  Storage characters
+    bool start_pending;                             //  Tape not up to speed
+    bool odd_parity;                                //  Unit B (odd) or U
+
+    int last_op;                                    //  Unit control, or -1
+    int run_op;                                     //  Positioning run:
+    TTapeUnit *run_unit;                            //  what, which drive,
+    long run_length;                                //  and how many so far
+    unsigned long display_ticks;                    //  Last panel repaint
+
+    TTapeTAUStats stats;                            //  Statistics
+    TTapeTAUStats job_stats;                        //  At start of job
+    TTapeStats job_unit_stats[10];                  //  Each drive, ditto
+    __int64 busy_since[10];                         //  First found busy
+
+    //  Frame translation tables, built once, the first time a TAU is
+    //  constructed.  Indexed first by odd_parity.  Going to tape, they take
+    //  a 6 bit character to the frame to write, with the check bit set for
+    //  the right parity, and even parity blanks already changed to C+A.
+    //  Coming from tape, they take a frame to the BCD character to give the
+    //  channel (in odd parity, C+A changed back to blank), with
+    //  TAPE_READ_CHECK on if the frame had the wrong parity.
+
+    static TTapeTAU *FirstTAU;                      //  List of all TAUs
+    TTapeTAU *NextTAU;
+
+    static bool tables_built;
+    static unsigned char tape_write_table[2][64];
+    static int tape_read_table[2][128];
+
+public:
+
+    //  Implement the I/O device interface standard
+
+    TTapeTAU(int devicenum, T1410Channel *Channel);
+    virtual int Select();
+    virtual void DoOutput();
+    virtual void DoInput();
+    virtual int StatusSample();
+    virtual void DoUnitControl(BCD opmod);
+    virtual long CharacterTime();
+
+    //  State and status methods
+
+    TTapeUnit *GetUnit(int unit);
+    inline TTapeTAUStats GetStats() { return stats; }
+    void ResetStats();                              //  Start of a job
+    void Report(int ch);                            //  Job report
+
+    static void FlushAll();                         //  End of job
+    static void CloseAll();                         //  Emergency off
+
+private:
+
+    //  Internal methods.
+
+    bool DoOutputWrite(char c);
+    int DoInputRead();
+    void Display(bool run);                         //  Repaint tape panel
+};
+
+
+#endif
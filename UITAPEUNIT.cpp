@@ -1,578 +1,972 @@
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-//---------------------------------------------------------------------------
-#include <vcl.h>
-#pragma hdrstop
-
-#include <dir.h>
-#include <stdio.h>
-#include <assert.h>
-#include "ubcd.h"
-#include "UI1410CPUT.h"
-#include "UITAPEUNIT.h"
-
-//---------------------------------------------------------------------------
-#pragma package(smart_init)
-
-#include "UI1410DEBUG.h"
-
-#define TAPEDEBUG   1
-
-//  Tape Unit Implementation.
-
-//  Constructor
-
-TTapeUnit::TTapeUnit(int u) {
-
-    fd = NULL;
-    BusyEntry = new TBusyDevice();                  //  Create a busy list entry
-    Init(u);                                        //  Let common init take over
-}
-
-//  Initialization (not sure if anyone else will ever use this)
-
-void TTapeUnit::Init(int u) {
-
-    if(fd != NULL) {
-        delete fd;
-    }
-
-    unit = u;
-    fd = NULL;
-    loaded = fileprotect = tapeindicate = ready = selected = bot = false;
-    write_irg = irg_read = modified = false;
-    highdensity = true;
-	filename = L"";
-    record_number = 0;
-    BusyEntry -> SetBusy(0);                        //  Set not busy.
-	return;
-}
-
-//  Method to reset file, if open, and reset flags.  Typically called
-//  after an error of some sort.
-
-void TTapeUnit::ResetFile() {
-
-    if(fd != NULL) {
-        delete fd;
-    }
-
-    fd = NULL;
-    ready = loaded = fileprotect = bot = false;
-    irg_read = write_irg = modified = false;
-    record_number = 0;
-    return;
-}
-
-
-//  Methods that interface to user interface buttons
-
-bool TTapeUnit::Reset() {
-    ready = false;
-    return(true);
-}
-
-//  Load the tape (file) (if not already loaded) and rewind.
-
-bool TTapeUnit::LoadRewind() {
-
-    if(ready) {                                     //  Inop if drive is ready
-        return(false);
-    }
-
-    if(modified && write_irg) {                     //  Write a closing 0 + IRG
-        assert(fd != NULL);
-        Write(0);
-        modified = false;
-    }
-
-    if(fd != NULL) {                                //  If loaded, just rewind
-
-        try {
-            fd -> Seek(0,soFromBeginning);
-            irg_read = modified = false;
-            write_irg = true;
-            record_number = 0;
-            return(bot = loaded = true);
-        }
-
-        catch(char *dummy) {
-            DEBUG("LoadRewind: Seek on failed on tape unit %d",unit);
-            ResetFile();
-            return(false);
-        }
-
-    }
-	else if(filename.Length() == 0) {
-		return(false);
-    }
-
-    //  Open the file.  First try RW.  If that fails, try RO and set fileprot.
-
-    try {
-        fd = new TFileStream(filename,fmOpenReadWrite | fmShareDenyWrite);
-        fileprotect = false;
-    }
-
-    catch(EFOpenError &e) {
-
-        try {
-            fd = new TFileStream(filename,fmOpenRead);
-            fileprotect = true;                         //  Read Only was OK
-        }
-
-        catch(EFOpenError &e) {
-            DEBUG("LoadRewind: open failed on tape unit %d",unit);
-            DEBUG("%s",AnsiString(e.Message).c_str());
-            ResetFile();
-            return(false);
-        }
-    }
-
-    irg_read = modified = false;
-    write_irg = true;
-    record_number = 0;
-    return(bot = loaded = true);
-}
-
-//  Unload the tape (file)
-
-bool TTapeUnit::Unload() {
-
-    if(ready || !loaded) {                          //  If ready, ignore.
-        return(false);
-    }
-
-    ResetFile();                                    //  Handles most of the work
-    tapeindicate = false;
-    return(true);
-}
-
-//  Mount a tape on the drive (associate a file)
-
-bool TTapeUnit::Mount(String fname) {
-
-	if(ready || loaded) {                           //  If ready or already
-		return(false);                              //  loaded, ignore it.
-	}
-
-	if(fname.Length() == 0) {
-		return(false);
-	}
-	assert(fd == NULL);
-	filename = fname;
-	irg_read = write_irg = fileprotect = tapeindicate = bot = modified = false;
-
-    return(true);
-}
-
-//  Start Button
-
-bool TTapeUnit::Start() {
-
-    if(ready || !loaded) {                          //  If ready or not loaded
-        return(false);                              //  can't help you!
-    }
-
-    assert(fd != NULL);
-
-    return(ready = true);
-}
-
-bool TTapeUnit::ChangeDensity() {
-    if(ready) {
-        return(false);
-    }
-    highdensity = !highdensity;
-    return(true);
-}
-
-//  Methods that interface with the Tape Adapter Unit (TAU)
-
-bool TTapeUnit::Select(bool b) {
-    selected = b;
-#ifdef TAPEDEBUG
-    if(fd != NULL && !BusyEntry -> TestBusy()) {
-        DEBUG("TTapeUnit unit %d selected",unit);
-		DEBUG("TTapeUnit Current file offset is %lld",fd -> Position);
-    }
-#endif
-    return(true);
-}
-
-//  Rewind to beginning of tape (file)
-
-bool TTapeUnit::Rewind() {
-
-    if(!selected || !loaded || !ready) {            //  Must be ready to go...
-        DEBUG("TTapeUnit::Rewind: Unit %d not selected or not ready",unit);
-        return(false);
-    }
-
-#ifdef TAPEDEBUG
-    DEBUG("Rewind unit %d",unit);
-#endif
-
-    assert(fd != NULL);
-
-    if(modified && write_irg) {                           //  Mark end of record
-        if(!Write(0)) {
-            return(false);
-        }
-        write_irg = modified = false;
-    }
-
-    try {
-        fd -> Seek(0,soFromBeginning);
-    }
-
-    catch(char *dummy) {
-        DEBUG("Rewind: Seek failed, unit %d",unit);
-        ResetFile();
-        return(false);
-    }
-
-    irg_read = modified = false;
-    write_irg = true;
-    BusyEntry -> SetBusy(5*record_number);            //  Act like we are busy
-    record_number = 0;
-    return(bot = true);
-}
-
-//  Rewind and unload the tape (close the file)
-
-bool TTapeUnit::RewindUnload() {
-
-    if(!Rewind()) {                                     //  If rewind fails...
-        ResetFile();
-        return(false);
-    }
-
-    ResetFile();
-    tapeindicate = false;
-    return(true);
-}
-
-//  Skip and blank tape, does nothing for now (until we have measured tape)
-
-bool TTapeUnit::Skip() {
-
-#ifdef TAPEDEBUG
-    DEBUG("Write IRG (Skip) unit %d",unit);
-#endif
-
-    if(!selected || !loaded || !ready) {
-        return(false);
-    }
-    write_irg = true;
-    return(true);
-}
-
-//  Space forward.  (d-character is "A" - not in my Principles of Operation!)
-//  Basically pretty easy: all we have to do is call read until we get a
-//  negative return code, which will happen at EOF or IRG or an error.
-//  We can let the Tape Adapter Unit figure out the status.
-
-int TTapeUnit::Space() {
-
-    int rc;
-
-#ifdef TAPEDEBUG
-    DEBUG("Space unit %d",unit);
-#endif
-
-    while((rc = Read()) >= 0) {
-        //  Do nothing.
-    }
-    BusyEntry -> SetBusy(2);                    //  Must go busy for a while
-    return(rc);
-}
-
-//  Backspace.  This one is a pain.  To do it, we take two steps back, one
-//  forward.  Repeatedly.  Slow.  Oh well....
-
-bool TTapeUnit::Backspace() {
-
-    if(!selected || !ready || !loaded) {
-        DEBUG("TTapeUnit::Backspace: Unit %d not selected or not ready",unit);
-        return(false);
-    }
-
-    assert(fd != NULL);
-
-#ifdef TAPEDEBUG
-	DEBUG("Backspace start: %lld",fd -> Position);
-#endif
-
-    if(bot) {                                           //  If at BOT, a NOP
-        record_number = 0;
-        return(true);
-    }
-
-    BusyEntry -> SetBusy(2);                            //  If not a BOT, go busy
-
-    //  If we just ended a record, write out its IRG, then back up before it.
-
-    if(modified && write_irg) {
-        if(!Write(0)) {
-            ResetFile();
-            return(false);
-        }
-        modified = write_irg = irg_read = false;
-
-        try {
-            fd -> Seek(-1,soFromCurrent);
-        }
-
-        catch(char *dummy) {
-            DEBUG("Backspace: Seek over EOR failed on unit %d",unit);
-            ResetFile();
-            return(false);
-        }
-
-    }
-
-    //  Now, go into the two steps back, one step forward routine.
-
-    while(true) {                                       //  Start the dance...
-
-        //  Seek back 2 characters
-
-        try {
-            fd -> Seek(-2,soFromCurrent);
-        }
-
-        catch(char *dummy) {
-            DEBUG("Backspace: Seek failed on unit %d",unit);
-            ResetFile();
-            return(false);
-        }
-
-        //  If beginning of file, done! (special case)
-
-        if(fd -> Position == 0) {
-            irg_read = false;
-            bot = write_irg = true;
-            record_number = 0;
-#ifdef TAPEDEBUG
-            DEBUG("Backspace end at BOT");
-#endif
-            return(true);
-        }
-
-        //  Read forward 1 character.  Quit on error or EOF
-
-        if(fd -> Read(&tape_buffer,1) != 1) {
-            DEBUG("Backspace: Read failed: unexpected eof on unit %d",unit);
-            return(false);
-        }
-
-        //  If we find an IRG bit on, we are done!  Have to leave the IRG
-        //  bit on the character, though.
-
-        if(tape_buffer & TAPE_IRG) {
-            irg_read = write_irg = true;
-            --record_number;
-#ifdef TAPEDEBUG
-			DEBUG("Backspace end: %lld",fd -> Position);
-#endif
-            return(true);
-        }
-    }
-}
-
-//  Method to write a character.  Note that by this time any cute stuff
-//  (like parity, changing wordmarks in to word separators, changing
-//  word separators into two word separators, etc. should have already been
-//  handled in the TAU
-
-bool TTapeUnit::Write(int c) {
-
-    if(!loaded || !ready || !selected || fd == NULL) {
-        DEBUG("TapeUnit::Write: Unit %d not ready or selected",unit);
-        return(false);
-    }
-
-    if(fileprotect) {
-        DEBUG("TapeUnit::Write: Attempt to write when file protected, unit %d",
-            unit);
-        return(false);
-    }
-
-    //  If we have an irg left over from a previous read, back up over it.
-
-    if(irg_read) {
-        try {
-			DEBUG("Write seeking back over EOR from: %lld",fd -> Position);
-            fd -> Seek(-1,soFromCurrent);
-			DEBUG("Write seeking back over EOR to: %lld",fd -> Position);
-            irg_read = false;
-            write_irg = modified = true;           //  Set modified to write IRG
-        }
-
-        catch(char *dummy) {
-            DEBUG("Write: Seek over EOR failed on unit %d",unit);
-            ResetFile();
-            return(false);
-        }
-    }
-
-    //  If we have an IRG left to do from a previous write,
-    //  or, if the last operation was a read, set the IRG bit.
-
-    if(write_irg) {
-        c |= TAPE_IRG;
-    }
-
-
-    if(fd -> Write(&c,1) != 1) {
-        DEBUG("TapeUnit::Write: File I/O error writing on unit %d",unit);
-        ResetFile();
-        tapeindicate = true;
-        return(false);
-    }
-
-    irg_read = write_irg = false;
-
-    return(true);
-}
-
-//  Mark end of record.  Called at the end of a transfer by the TAU.
-//  All this does is set the IRG flag for the start of the next record.
-
-void TTapeUnit::WriteIRG() {
-    write_irg = modified = true;
-    bot = irg_read = false;
-    ++record_number;
-
-#ifdef TAPEDEBUG
-    DEBUG("TTapeUnit::WriteIRG unit %d",unit);
-    if(fd != NULL) {
-		DEBUG("TTapeUnit Current file position is %lld",fd -> Position);
-    }
-#endif
-
-    return;
-}
-
-//  Write tape mark.  Just calls write to do the dirty work...
-//  Note that tape marks are *always* even parity.  Since this writes
-//  an IRG and flushes, it also clears the modified flag.
-
-bool TTapeUnit::WriteTM() {
-    bool status;
-
-    ++record_number;
-
-#ifdef TAPEDEBUG
-    DEBUG("Write TM %d",unit);
-#endif
-
-	if(!Write((unsigned int)(TAPE_TM | TAPE_IRG))) {
-		return(false);
-    }
-    irg_read = modified = bot = false;
-    status = Write(TAPE_TM);
-    write_irg = modified = true;
-
-#ifdef TAPEDEBUG
-	DEBUG("Write TM end: %lld",fd -> Position);
-#endif
-
-    BusyEntry -> SetBusy(2);                       //  Go busy
-
-    return(status);
-}
-
-//  Read a character.
-
-int TTapeUnit::Read() {
-
-    int rc;
-
-    if(!loaded || !ready || !selected || fd == NULL) {
-        DEBUG("TapeUnit::Read: Unit not ready or selected: %d",unit);
-        return(TAPEUNITNOTREADY);
-    }
-
-    //  Read a character, unless the last read resulted in an IRG, in
-    //  which case it is already in the buffer.
-    //  Interesting statuses are negative, just bubble them on up.
-
-    if(!irg_read) {
-        if((rc = ReadNextChar()) < 0) {
-            return(rc);
-        }
-        tape_buffer = (char) rc;
-    }
-
-    //  If we are at bot or an IRG, strip the IRG bit from the char.
-    //  We will then just return that char.
-
-    //  A Tape Mark is only a Tape Mark as the first character.  Also,
-    //  when we first see it at the end of a record, it just denotes the
-    //  IRG.  (Which means we need to save it in tape_buffer, too)
-
-    if(bot || irg_read) {
-        tape_buffer &= (char) (~TAPE_IRG);
-        if((tape_buffer & 0x3f) == TAPE_TM) {
-            tapeindicate = true;
-        }
-        bot = irg_read = false;
-    }
-
-    //  If we hit the end of the record, then set irg now, and return such
-
-    if(tape_buffer & TAPE_IRG) {
-#ifdef TAPEDEBUG
-        DEBUG("TTapeUnit::Read: Found IRG character at %lld", fd -> Position);
-#endif
-        irg_read = true;
-        bot = false;
-        ++record_number;
-        return(TAPEUNITIRG);
-    }
-
-    //  Aw shucks, just return the blinkin' character already!
-
-    //  Clear irg at this point too, becuase if we had an IRG bit,
-    //  it got handled in the preceeding IF.  If we hit EOF, the value
-    //  in the character is a tape mark with an IRG.
-
-    irg_read = false;
-    return(tape_buffer);
-}
-
-//  Utility method to read a character from the file, and handle a few odds
-//  and ends.  Keeps us from having to do it all more than once...
-
-int TTapeUnit::ReadNextChar() {
-
-    unsigned char c;
-
-    write_irg = true;                           //  Next write must write IRG
-
-    if(fd -> Read(&c,1) != 1) {
-		DEBUG("TapeUnit::ReadNextChar: Error or EOF in Read, unit %d",unit);
-        return(TAPE_TM | TAPE_IRG);
-    }
-    return(c);
-}
-
-
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//---------------------------------------------------------------------------
+#include <vcl.h>
+#pragma hdrstop
+
+#include <dir.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "ubcd.h"
+#include "UI1410CPUT.h"
+#include "UITAPEFILE.h"
+#include "UITAPEINDEX.h"
+#include "UITAPEUNIT.h"
+
+//---------------------------------------------------------------------------
+#pragma package(smart_init)
+
+#include "UI1410DEBUG.h"
+
+#define TAPEDEBUG   1
+
+//  Tape Unit Implementation.
+
+//  Constructor
+
+TTapeUnit::TTapeUnit(int u) {
+
+    fd = NULL;
+    index = new TTapeIndex();
+    record = new unsigned char[TAPE_RECORD_BUFFER];
+    record_capacity = TAPE_RECORD_BUFFER;
+    BusyEntry = new TBusyDevice();                  //  Create a busy list entry
+    Init(u);                                        //  Let common init take over
+}
+
+//  Initialization (not sure if anyone else will ever use this)
+
+void TTapeUnit::Init(int u) {
+
+    CloseFile();
+    unit = u;
+    index -> Clear();
+    loaded = fileprotect = tapeindicate = ready = selected = bot = false;
+    write_irg = irg_read = modified = false;
+    highdensity = true;
+    density = TAPE_BPI_556;
+    stopped_time = 0;
+	filename = L"";
+    record_number = 0;
+    memset(&stats,0,sizeof(stats));
+    record_length = 0;
+    checkpointed = false;
+    BusyEntry -> SetBusy(0);                        //  Set not busy.
+	return;
+}
+
+//  Method to reset file, if open, and reset flags.  Typically called
+//  after an error of some sort.
+
+void TTapeUnit::ResetFile() {
+
+    CloseFile();
+    ready = loaded = fileprotect = bot = false;
+    irg_read = write_irg = modified = false;
+    record_number = 0;
+    record_length = 0;
+    checkpointed = false;
+    index -> Clear();
+    return;
+}
+
+//  Private method to get rid of the file (which closes it), after adding
+//  its host I/O counts to ours.
+
+void TTapeUnit::CloseFile() {
+
+    if(fd == NULL) {
+        return;
+    }
+    stats.HostCalls += fd -> GetHostCalls();
+    stats.HostMicroseconds += fd -> GetHostMicroseconds();
+    delete fd;
+    fd = NULL;
+}
+
+//  Return the statistics, including the host I/O for the file that is
+//  open now, if any.
+
+TTapeStats TTapeUnit::GetStats() {
+
+    TTapeStats s = stats;
+
+    if(fd != NULL) {
+        s.HostCalls += fd -> GetHostCalls();
+        s.HostMicroseconds += fd -> GetHostMicroseconds();
+    }
+    return(s);
+}
+
+//  Method to close the file normally, and save the record index next to
+//  it, so that we don't have to build it all over again next time.  The
+//  file has to be closed first so that the index gets the final size and
+//  time stamp of the file.  Once it is safely on disk, it doesn't need
+//  recovering any more.
+
+void TTapeUnit::SaveIndex() {
+
+    __int64 size;
+
+    if(fd == NULL || !CommitRecord()) {
+        return;
+    }
+
+    if(!fd -> Sync()) {
+        DEBUG("SaveIndex: Sync failed on tape unit %d",unit);
+    }
+    size = fd -> GetSize();
+    CloseFile();
+    index -> Save(filename,size);
+    Checkpoint(true);
+}
+
+//  Private method to write the record we have been building up out to
+//  the file, all in one go.  Output tapes used to be written a frame at a
+//  time, and if the emulator died in the middle of a record, the tape
+//  was left with half of it.  The record is followed by a closing IRG
+//  frame, so the image always ends with a whole record, even if we never
+//  get to the next one.  We are left sitting on the closing frame, so
+//  that the next record (if there is one) writes right over it.
+
+bool TTapeUnit::CommitRecord() {
+
+    __int64 pos;
+
+    if(record_length == 0) {
+        return(true);
+    }
+
+    if(fd == NULL) {
+        record_length = 0;
+        return(false);
+    }
+
+    //  The first record we write gets us a .wip file, in case we die.
+    //  Writing on a real tape leaves whatever was after it unreadable, so
+    //  the rest of the image goes first.  Then everything past the good
+    //  position in the .wip was written by us, in whole records.
+
+    if(!checkpointed) {
+        index -> Invalidate(fd -> GetPosition());
+        if(!fd -> Truncate(fd -> GetPosition())) {
+            DEBUG("TapeUnit::CommitRecord: Can't cut off old data on unit %d",
+                unit);
+        }
+        Checkpoint(false);
+    }
+
+    pos = fd -> GetPosition() + record_length;
+    record[record_length] = TAPE_IRG;
+    index -> Invalidate(pos);
+
+    if(fd -> Write(record,record_length+1) != record_length+1) {
+        DEBUG("TapeUnit::CommitRecord: File I/O error writing on unit %d",
+            unit);
+        ResetFile();
+        tapeindicate = true;
+        return(false);
+    }
+
+    fd -> Seek(-1,soFromCurrent);
+    index -> Frame(pos,TAPE_IRG);
+    record_length = 0;
+    return(true);
+}
+
+//  Private method to keep the "write in progress" file next to the image
+//  up to date.  It is there from the first record we write until the tape
+//  is rewound or unloaded, and holds a position at which the tape was
+//  last known to be good (on disk, and ending in a closing IRG).  If it is
+//  still there when the tape is mounted again, we died while writing, and
+//  Recover() cleans up.  If done is true, the tape has been synced, so the
+//  file can go away.
+
+bool TTapeUnit::Checkpoint(bool done) {
+
+    String wipname = filename + ".wip";
+    TFileStream *wip;
+    __int64 pos;
+
+    if(done) {
+        if(checkpointed) {
+            _wremove(wipname.c_str());
+            checkpointed = false;
+        }
+        return(true);
+    }
+
+    pos = fd -> GetPosition();
+
+    try {
+        wip = new TFileStream(wipname,fmCreate);
+        wip -> Write(&pos,sizeof(pos));
+        delete wip;
+    }
+    catch(Exception &e) {
+        DEBUG("Checkpoint: can't write %s",AnsiString(wipname).c_str());
+        return(false);
+    }
+
+    checkpointed = true;
+    return(true);
+}
+
+//  Private method called when a tape is loaded.  If there is a .wip file
+//  next to it, we died while writing it last time, and the last record
+//  may be only partly there.  The image was cut off at the good position
+//  in the .wip file before we wrote anything (see CommitRecord), so all
+//  that is past it is records we wrote.  Every record we commit ends in a
+//  closing IRG frame, and no other frame is ever just an IRG (a blank is
+//  written as C+A), so the tape really ends after the last closing frame
+//  past the good position.  Anything after that is cut off.
+
+void TTapeUnit::Recover() {
+
+    String wipname = filename + ".wip";
+    TFileStream *wip;
+    unsigned char chunk[TAPE_RECORD_BUFFER];
+    __int64 good = 0, pos, end = -1;
+    int n, i;
+
+    if(!FileExists(wipname)) {
+        return;
+    }
+
+    try {
+        wip = new TFileStream(wipname,fmOpenRead);
+        if(wip -> Read(&good,sizeof(good)) != sizeof(good)) {
+            good = 0;
+        }
+        delete wip;
+    }
+    catch(Exception &e) {
+        DEBUG("Recover: can't read %s",AnsiString(wipname).c_str());
+        return;
+    }
+
+    if(fileprotect) {
+        DEBUG("Recover: tape unit %d was not closed, but is file protected",
+            unit);
+        return;
+    }
+
+    if(good < 0 || good > fd -> GetSize()) {
+        good = 0;
+    }
+
+    fd -> Seek(good,soFromBeginning);
+    for(pos = good; (n = fd -> Read(chunk,sizeof(chunk))) > 0; pos += n) {
+        for(i=0; i < n; ++i) {
+            if(chunk[i] == TAPE_IRG) {
+                end = pos + i;
+            }
+        }
+    }
+
+    end = (end >= 0) ? end + 1 : good;
+
+    if(end < fd -> GetSize()) {
+        DEBUG("Recover: tape unit %d: cutting off %lld frames at %lld",
+            unit,fd -> GetSize() - end,end);
+        if(!fd -> Truncate(end)) {
+            return;
+        }
+
+        //  If there wasn't a closing frame at all, put one back where the
+        //  good part ends.
+
+        if(end == good && good > 0) {
+            chunk[0] = TAPE_IRG;
+            fd -> Seek(good,soFromBeginning);
+            fd -> Write(chunk,1);
+        }
+    }
+
+    fd -> Seek(0,soFromBeginning);
+    if(fd -> Sync()) {
+        checkpointed = true;
+        Checkpoint(true);
+    }
+}
+
+
+//  Methods that interface to user interface buttons
+
+bool TTapeUnit::Reset() {
+    ready = false;
+    return(true);
+}
+
+//  Load the tape (file) (if not already loaded) and rewind.
+
+bool TTapeUnit::LoadRewind() {
+
+    if(ready) {                                     //  Inop if drive is ready
+        return(false);
+    }
+
+    if(modified && write_irg) {                     //  Write a closing 0 + IRG
+        assert(fd != NULL);
+        Write(0);
+        modified = false;
+    }
+
+    if(fd != NULL) {                                //  If loaded, just rewind
+
+        try {
+            if(!CommitRecord()) {
+                return(false);
+            }
+            if(fd -> Sync()) {
+                Checkpoint(true);
+            }
+            fd -> Seek(0,soFromBeginning);
+            irg_read = modified = false;
+            write_irg = true;
+            record_number = 0;
+            return(bot = loaded = true);
+        }
+
+        catch(char *dummy) {
+            DEBUG("LoadRewind: Seek on failed on tape unit %d",unit);
+            ResetFile();
+            return(false);
+        }
+
+    }
+	else if(filename.Length() == 0) {
+		return(false);
+    }
+
+    //  Open the file.  First try RW.  If that fails, try RO and set fileprot.
+
+    try {
+        fd = new TTapeFile(filename,false);
+        fileprotect = false;
+    }
+
+    catch(EFOpenError &e) {
+
+        try {
+            fd = new TTapeFile(filename,true);
+            fileprotect = true;                         //  Read Only was OK
+#ifdef TAPEDEBUG
+            if(fd -> IsMapped()) {
+                DEBUG("LoadRewind: tape unit %d image is mapped",unit);
+            }
+#endif
+        }
+
+        catch(EFOpenError &e) {
+            DEBUG("LoadRewind: open failed on tape unit %d",unit);
+            DEBUG("%s",AnsiString(e.Message).c_str());
+            ResetFile();
+            return(false);
+        }
+    }
+
+    Recover();                                      //  If we died writing
+    index -> Load(filename,fd -> GetSize());        //  Pick up saved index
+
+    irg_read = modified = false;
+    write_irg = true;
+    record_number = 0;
+    return(bot = loaded = true);
+}
+
+//  Unload the tape (file)
+
+bool TTapeUnit::Unload() {
+
+    if(ready || !loaded) {                          //  If ready, ignore.
+        return(false);
+    }
+
+    SaveIndex();
+    ResetFile();                                    //  Handles most of the work
+    tapeindicate = false;
+    return(true);
+}
+
+//  Get whatever has been written out to the disk, at the end of a run,
+//  so that it is there even if the emulator is never shut down properly.
+//  Once it is there, the tape doesn't need recovering any more.  (The
+//  tape stays mounted, and the next record written starts a new .wip.)
+
+bool TTapeUnit::Flush() {
+
+    if(fd == NULL) {
+        return(true);
+    }
+    if(!CommitRecord()) {
+        return(false);
+    }
+    if(!fd -> Sync()) {
+        DEBUG("Flush: Sync failed on tape unit %d",unit);
+        return(false);
+    }
+    Checkpoint(true);
+    return(true);
+}
+
+//  Close the tape down when the emulator is going away:  everything goes
+//  out to the disk, and the record index is saved next to it.
+
+void TTapeUnit::Close() {
+
+    if(fd == NULL) {
+        return;
+    }
+    SaveIndex();
+    ResetFile();
+}
+
+//  Mount a tape on the drive (associate a file)
+
+bool TTapeUnit::Mount(String fname) {
+
+	if(ready || loaded) {                           //  If ready or already
+		return(false);                              //  loaded, ignore it.
+	}
+
+	if(fname.Length() == 0) {
+		return(false);
+	}
+	assert(fd == NULL);
+	filename = fname;
+	irg_read = write_irg = fileprotect = tapeindicate = bot = modified = false;
+
+    return(true);
+}
+
+//  Start Button
+
+bool TTapeUnit::Start() {
+
+    if(ready || !loaded) {                          //  If ready or not loaded
+        return(false);                              //  can't help you!
+    }
+
+    assert(fd != NULL);
+
+    return(ready = true);
+}
+
+bool TTapeUnit::ChangeDensity() {
+    if(ready) {
+        return(false);
+    }
+    highdensity = !highdensity;
+    return(true);
+}
+
+//  Methods that interface with the Tape Adapter Unit (TAU)
+
+bool TTapeUnit::Select(bool b) {
+    selected = b;
+#ifdef TAPEDEBUG
+    if(fd != NULL && !BusyEntry -> TestBusy()) {
+        DEBUG("TTapeUnit unit %d selected",unit);
+		DEBUG("TTapeUnit Current file offset is %lld",fd -> GetPosition());
+    }
+#endif
+    return(true);
+}
+
+//  Rewind to beginning of tape (file)
+
+bool TTapeUnit::Rewind() {
+
+    __int64 inches;
+
+    if(!selected || !loaded || !ready) {            //  Must be ready to go...
+        DEBUG("TTapeUnit::Rewind: Unit %d not selected or not ready",unit);
+        return(false);
+    }
+
+#ifdef TAPEDEBUG
+    DEBUG("Rewind unit %d",unit);
+#endif
+
+    assert(fd != NULL);
+
+    //  Any record still being written goes out, with its closing IRG.
+
+    if(!CommitRecord()) {
+        return(false);
+    }
+    write_irg = modified = false;
+
+    //  The rewind takes time depending upon how much tape is out there.
+
+    inches = fd -> GetPosition() / density;
+
+    //  Anything written so far has to go out to the disk now.  Then we
+    //  won't need to recover it.
+
+    if(!fd -> Sync()) {
+        DEBUG("Rewind: Sync failed, unit %d",unit);
+        ResetFile();
+        return(false);
+    }
+    Checkpoint(true);
+
+    try {
+        fd -> Seek(0,soFromBeginning);
+    }
+
+    catch(char *dummy) {
+        DEBUG("Rewind: Seek failed, unit %d",unit);
+        ResetFile();
+        return(false);
+    }
+
+    ++stats.Rewinds;
+    irg_read = modified = false;
+    write_irg = true;
+    BusyEntry -> SetBusyCycles(TVirtualClock::FromMicroseconds(TAPE_REWIND_US) +
+        (long) (inches * BUSY_CYCLES_PER_MS * 1000 / TAPE_REWIND_IPS));
+    stopped_time = BusyEntry -> GetBusyUntil();
+    record_number = 0;
+    return(bot = true);
+}
+
+//  Rewind and unload the tape (close the file)
+
+bool TTapeUnit::RewindUnload() {
+
+    if(!Rewind()) {                                     //  If rewind fails...
+        ResetFile();
+        return(false);
+    }
+
+    SaveIndex();
+    ResetFile();
+    tapeindicate = false;
+    return(true);
+}
+
+//  Skip and blank tape, does nothing for now (until we have measured tape)
+//  except add the time for the long gap to the start of the next record.
+
+bool TTapeUnit::Skip() {
+
+#ifdef TAPEDEBUG
+    DEBUG("Write IRG (Skip) unit %d",unit);
+#endif
+
+    if(!selected || !loaded || !ready) {
+        return(false);
+    }
+    write_irg = true;
+    if(stopped_time < TVirtualClock::Now()) {
+        stopped_time = TVirtualClock::Now();
+    }
+    stopped_time += TVirtualClock::FromMicroseconds(TAPE_LONG_GAP_US);
+    return(true);
+}
+
+//  Space forward.  (d-character is "A" - not in my Principles of Operation!)
+//  Basically pretty easy: all we have to do is call read until we get a
+//  negative return code, which will happen at EOF or IRG or an error.
+//  We can let the Tape Adapter Unit figure out the status.
+
+//  Rather than actually reading every character, once we have read the
+//  first one (which takes care of BOT, tape marks and EOF) we look up the
+//  start of the next record in the index and go right to it.  The read
+//  loop then just picks up the IRG there.
+
+int TTapeUnit::Space() {
+
+    int rc, n;
+    long chars = 0;
+    long start = StartDelay();
+    __int64 pos, next;
+
+#ifdef TAPEDEBUG
+    DEBUG("Space unit %d",unit);
+#endif
+
+    if((rc = Read()) >= 0) {
+        ++chars;
+        pos = fd -> GetPosition();
+        n = index -> Next(fd,pos);
+        next = (n >= 0) ? index -> GetOffset(n) : fd -> GetSize();
+        if(next > pos) {
+            chars += (long) (next - pos);
+            stats.FramesRead += next - pos;
+            fd -> Seek(next,soFromBeginning);
+        }
+        while((rc = Read()) >= 0) {
+            ++chars;
+        }
+    }
+    GoBusy(start,chars,0);                      //  Must go busy for a while
+    return(rc);
+}
+
+//  Backspace.  This used to be a pain: we took two steps back, one
+//  forward, repeatedly, looking for the IRG bit.  Now we just look up the
+//  start of the record behind us in the index.
+
+bool TTapeUnit::Backspace() {
+
+    __int64 startpos, pos;
+    long start;
+    int n;
+
+    if(!selected || !ready || !loaded) {
+        DEBUG("TTapeUnit::Backspace: Unit %d not selected or not ready",unit);
+        return(false);
+    }
+
+    assert(fd != NULL);
+
+    if(!CommitRecord()) {                               //  Finish any record
+        return(false);
+    }
+
+#ifdef TAPEDEBUG
+	DEBUG("Backspace start: %lld",fd -> GetPosition());
+#endif
+
+    if(bot) {                                           //  If at BOT, a NOP
+        record_number = 0;
+        return(true);
+    }
+
+    startpos = fd -> GetPosition();                          //  For timing
+    start = StartDelay();
+    ++stats.Backspaces;
+
+    //  If we just ended a record, its closing IRG is already out there,
+    //  and we are sitting on it.
+
+    if(modified && write_irg) {
+        modified = write_irg = irg_read = false;
+    }
+
+    //  The frame just behind us is the IRG frame of the record we stopped
+    //  at (if we stopped at one), so the record we want is the last one
+    //  that starts at least two frames back.
+
+    pos = fd -> GetPosition() - 2;
+    n = (pos > 0) ? index -> Last(fd,pos) : -1;
+
+    //  If there isn't one, or it is the first record, we are at BOT.
+
+    if(n < 0 || index -> GetOffset(n) == 0) {
+        fd -> Seek(0,soFromBeginning);
+        irg_read = false;
+        bot = write_irg = true;
+        record_number = 0;
+        GoBusy(start,(long) startpos,0);                //  Go busy
+#ifdef TAPEDEBUG
+        DEBUG("Backspace end at BOT");
+#endif
+        return(true);
+    }
+
+    //  Otherwise, read the first character, with its IRG bit (Read()
+    //  expects to find it in tape_buffer, just as if we had stopped there
+    //  reading forward).
+
+    fd -> Seek(index -> GetOffset(n),soFromBeginning);
+    if(fd -> Read(&tape_buffer,1) != 1) {
+        DEBUG("Backspace: Read failed: unexpected eof on unit %d",unit);
+        return(false);
+    }
+
+    irg_read = write_irg = true;
+    record_number = n;
+    GoBusy(start,(long) (startpos - fd -> GetPosition()),0);
+#ifdef TAPEDEBUG
+    DEBUG("Backspace end: %lld",fd -> GetPosition());
+#endif
+    return(true);
+}
+
+//  Method to write a character.  Note that by this time any cute stuff
+//  (like parity, changing wordmarks in to word separators, changing
+//  word separators into two word separators, etc. should have already been
+//  handled in the TAU
+
+bool TTapeUnit::Write(int c) {
+
+    __int64 pos;
+    unsigned char *b;
+
+    if(!loaded || !ready || !selected || fd == NULL) {
+        DEBUG("TapeUnit::Write: Unit %d not ready or selected",unit);
+        return(false);
+    }
+
+    if(fileprotect) {
+        DEBUG("TapeUnit::Write: Attempt to write when file protected, unit %d",
+            unit);
+        return(false);
+    }
+
+    //  If we have an irg left over from a previous read, back up over it.
+
+    if(irg_read) {
+        try {
+			DEBUG("Write seeking back over EOR from: %lld",fd -> GetPosition());
+            fd -> Seek(-1,soFromCurrent);
+			DEBUG("Write seeking back over EOR to: %lld",fd -> GetPosition());
+            irg_read = false;
+            write_irg = modified = true;           //  Set modified to write IRG
+        }
+
+        catch(char *dummy) {
+            DEBUG("Write: Seek over EOR failed on unit %d",unit);
+            ResetFile();
+            return(false);
+        }
+    }
+
+    //  If we have an IRG left to do from a previous write,
+    //  or, if the last operation was a read, set the IRG bit.
+
+    if(write_irg) {
+        c |= TAPE_IRG;
+    }
+
+    //  The character just goes into the record.  The record goes out to
+    //  the file when it ends (see CommitRecord).  Leave room for the
+    //  closing IRG frame.
+
+    pos = fd -> GetPosition() + record_length;
+    index -> Invalidate(pos);
+
+    if(record_length + 1 >= record_capacity) {
+        b = new unsigned char[2 * record_capacity];
+        memcpy(b,record,record_length);
+        delete[] record;
+        record = b;
+        record_capacity *= 2;
+    }
+    record[record_length++] = (unsigned char) c;
+    ++stats.FramesWritten;
+
+    index -> Frame(pos,c);
+
+    irg_read = write_irg = false;
+
+    return(true);
+}
+
+//  Mark end of record.  Called at the end of a transfer by the TAU.
+//  Writes the record out, and sets the IRG flag for the start of the
+//  next record.
+
+void TTapeUnit::WriteIRG() {
+    CommitRecord();
+    write_irg = modified = true;
+    bot = irg_read = false;
+    ++record_number;
+    ++stats.RecordsWritten;
+    EndRecord();
+
+#ifdef TAPEDEBUG
+    DEBUG("TTapeUnit::WriteIRG unit %d",unit);
+    if(fd != NULL) {
+		DEBUG("TTapeUnit Current file position is %lld",fd -> GetPosition());
+    }
+#endif
+
+    return;
+}
+
+//  Write tape mark.  Just calls write to do the dirty work...
+//  Note that tape marks are *always* even parity.  Since this writes
+//  an IRG and flushes, it also clears the modified flag.
+
+bool TTapeUnit::WriteTM() {
+    bool status;
+    long start = StartDelay();
+
+    ++record_number;
+    ++stats.RecordsWritten;
+    ++stats.TapeMarksWritten;
+
+#ifdef TAPEDEBUG
+    DEBUG("Write TM %d",unit);
+#endif
+
+	if(!Write((unsigned int)(TAPE_TM | TAPE_IRG))) {
+		return(false);
+    }
+    irg_read = modified = bot = false;
+    status = Write(TAPE_TM) && CommitRecord();
+    write_irg = modified = true;
+
+    //  A tape mark is a good time to make sure it is all out on the disk,
+    //  and to note that the tape is good up to here.
+
+    if(status && !fd -> Sync()) {
+        DEBUG("TapeUnit::WriteTM: File I/O error writing on unit %d",unit);
+        tapeindicate = true;
+        status = false;
+    }
+    if(status) {
+        Checkpoint(false);
+    }
+
+#ifdef TAPEDEBUG
+    if(fd != NULL) {
+	    DEBUG("Write TM end: %lld",fd -> GetPosition());
+    }
+#endif
+
+    GoBusy(start,1,TAPE_LONG_GAP_US);              //  Go busy
+
+    return(status);
+}
+
+//  Read a character.
+
+int TTapeUnit::Read() {
+
+    int rc;
+
+    if(!loaded || !ready || !selected || fd == NULL) {
+        DEBUG("TapeUnit::Read: Unit not ready or selected: %d",unit);
+        return(TAPEUNITNOTREADY);
+    }
+
+    if(!CommitRecord()) {                           //  Reading after writing
+        return(TAPEUNITERROR);
+    }
+
+    //  Read a character, unless the last read resulted in an IRG, in
+    //  which case it is already in the buffer.
+    //  Interesting statuses are negative, just bubble them on up.
+
+    if(!irg_read) {
+        if((rc = ReadNextChar()) < 0) {
+            return(rc);
+        }
+        tape_buffer = (char) rc;
+    }
+
+    //  If we are at bot or an IRG, strip the IRG bit from the char.
+    //  We will then just return that char.
+
+    //  A Tape Mark is only a Tape Mark as the first character.  Also,
+    //  when we first see it at the end of a record, it just denotes the
+    //  IRG.  (Which means we need to save it in tape_buffer, too)
+
+    if(bot || irg_read) {
+        tape_buffer &= (char) (~TAPE_IRG);
+        if((tape_buffer & 0x3f) == TAPE_TM) {
+            tapeindicate = true;
+            ++stats.TapeMarksRead;
+        }
+        bot = irg_read = false;
+    }
+
+    //  If we hit the end of the record, then set irg now, and return such
+
+    if(tape_buffer & TAPE_IRG) {
+#ifdef TAPEDEBUG
+        DEBUG("TTapeUnit::Read: Found IRG character at %lld", fd -> GetPosition());
+#endif
+        irg_read = true;
+        bot = false;
+        ++record_number;
+        ++stats.RecordsRead;
+        EndRecord();
+        return(TAPEUNITIRG);
+    }
+
+    //  Aw shucks, just return the blinkin' character already!
+
+    //  Clear irg at this point too, becuase if we had an IRG bit,
+    //  it got handled in the preceeding IF.  If we hit EOF, the value
+    //  in the character is a tape mark with an IRG.
+
+    irg_read = false;
+    return(tape_buffer);
+}
+
+//  Utility method to read a character from the file, and handle a few odds
+//  and ends.  Keeps us from having to do it all more than once...
+
+int TTapeUnit::ReadNextChar() {
+
+    unsigned char c;
+    __int64 pos = fd -> GetPosition();
+
+    write_irg = true;                           //  Next write must write IRG
+
+    if(fd -> Read(&c,1) != 1) {
+		DEBUG("TapeUnit::ReadNextChar: Error or EOF in Read, unit %d",unit);
+        return(TAPE_TM | TAPE_IRG);
+    }
+    index -> Frame(pos,c);                      //  Keep index up to date
+    ++stats.FramesRead;
+    return(c);
+}
+
+//  Timing model methods.
+
+//  Return the time, in storage cycles, that it takes one character to go
+//  by the heads at the current density.
+
+long TTapeUnit::CharacterTime() {
+    return(TVirtualClock::FromNanoseconds(
+        1000000000L / ((long) density * TAPE_IPS)));
+}
+
+//  Return the time, in storage cycles, before the first character of a
+//  new record gets to the heads.  If the tape is still stopping from
+//  the last record, that has to finish first.
+
+long TTapeUnit::StartDelay() {
+
+    long delay = TVirtualClock::FromMicroseconds(TAPE_START_US);
+
+    if(stopped_time > TVirtualClock::Now()) {
+        delay += (long) (stopped_time - TVirtualClock::Now());
+    }
+    return(delay);
+}
+
+//  At the end of a record the tape stops in the inter-record gap.  The
+//  drive is not busy while it stops, but the next record has to wait.
+
+void TTapeUnit::EndRecord() {
+    stopped_time = TVirtualClock::Now() +
+        TVirtualClock::FromMicroseconds(TAPE_STOP_US);
+}
+
+//  Private method to go busy for a unit control operation that starts
+//  the tape ("start" is StartDelay() from before the operation), moves
+//  "chars" characters of tape, plus an extra gap (in microseconds),
+//  and then stops.
+
+void TTapeUnit::GoBusy(long start, long chars, long gap) {
+
+    BusyEntry -> SetBusyCycles(start + chars * CharacterTime() +
+        TVirtualClock::FromMicroseconds(gap + TAPE_STOP_US));
+    stopped_time = BusyEntry -> GetBusyUntil();
+}
@@ -1,109 +1,177 @@
-//---------------------------------------------------------------------------
-#ifndef UITAPEUNITH
-#define UITAPEUNITH
-//---------------------------------------------------------------------------
-
-/* 
- *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
- *  
- *  This program is free software: you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License as published by
- *  the Free Software Foundation, either version 3 of the License, or
- *  (at your option) any later version.
- *
- *  This program is distributed in the hope that it will be useful,
- *  but WITHOUT ANY WARRANTY; without even the implied warranty of
- *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *  GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  (file COPYING.txt) along with this program.  
- *  If not, see <https://www.gnu.org/licenses/>.
-*/
-
-//  Define constants returned by Read()
-
-#define TAPEUNITIRG     (-1)
-#define TAPEUNITEOF     (-2)
-#define TAPEUNITNOTREADY    (-3)
-#define TAPEUNITERROR   (-4)
-
-#define TAPE_IRG        0x80
-#define TAPE_TM         0x0f
-
-class TTapeUnit : public TObject {
-
-protected:
-
-    int unit;                                       //  Unit number.
-
-    String filename;		                        //  Path to tape file
-    TFileStream *fd;                                //  File Descripter for I/O
-    char tape_buffer;                               //  Char read from file
-
-    int record_number;                              //  Record number (0=bot)
-
-    bool loaded;                                    //  State flags
-    bool fileprotect;
-    bool ready;
-    bool selected;
-    bool tapeindicate;
-    bool highdensity;
-    bool bot;
-
-    bool irg_read;                                  //  True if tape_buffer full
-    bool write_irg;                                 //  Write IRG on next write
-    bool modified;
-
-    TBusyDevice *BusyEntry;
-
-private:
-
-	int ReadNextChar();                             //  Factored I/O call
-    void ResetFile();                               //  Close file, reset flags
-
-public:
-
-    //  Functions to make part of state visible to the outside
-
-    inline bool Selected() { return selected; }
-    inline bool IsReady() { return ready; }
-    inline bool IsFileProtected() { return fileprotect; }
-    inline bool TapeIndicate() { return tapeindicate; }
-    inline void ResetIndicate() { tapeindicate = false; }
-    inline bool HighDensity() { return highdensity; }
-    inline String GetFileName() { return filename; }
-    inline bool IsLoaded() { return loaded; }
-    inline bool IsBusy() { return BusyEntry -> TestBusy(); }
-    TBusyDevice *GetBusyDevice() { return BusyEntry; }
-    inline bool IsAtBot() { return bot; }
-    inline int GetRecordNumber() { return record_number; }
-
-    //  Interface functions for the User Interface buttons
-
-    bool LoadRewind();
-    bool Reset();
-    bool Unload();
-    bool Start();
-    bool ChangeDensity();
-    bool Mount(String filename);
-
-    //  Interface functions for the Tape Adapter Unit (TAU) to use
-
-    TTapeUnit(int u);                               //  Constructor
-    void Init(int u);                               //  Initialization
-
-    bool Select(bool b);                            //  Select or De-select unit
-    bool Rewind();
-    bool RewindUnload();
-    bool Backspace();
-    bool Skip();                                    //  Skip and blank tape
-    void WriteIRG();                                //  Mark end of record
-    bool WriteTM();                                 //  Write Tape Mark (EOF)
-    int Space();                                    //  Space fwd 1 record
-
-    int Read();                                     //  Returns char or -value
-    bool Write(int c);                             //  Write file character
-};
-
-#endif
+//---------------------------------------------------------------------------
+#ifndef UITAPEUNITH
+#define UITAPEUNITH
+//---------------------------------------------------------------------------
+
+/* 
+ *  COPYRIGHT 1998, 1999, 2000, 2019 Jay R. Jaeger
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  (file COPYING.txt) along with this program.  
+ *  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//  Define constants returned by Read()
+
+#define TAPEUNITIRG     (-1)
+#define TAPEUNITEOF     (-2)
+#define TAPEUNITNOTREADY    (-3)
+#define TAPEUNITERROR   (-4)
+
+#define TAPE_IRG        0x80
+#define TAPE_TM         0x0f
+
+//  729 timing model.  These are for a 729 II / V moving tape at 75
+//  inches per second.  The tape stops in the inter-record gap after
+//  each record, and has to get back up to speed before the next one, so
+//  the drive is busy for the stop plus start time after every record.
+//  The character rate depends on the density the drive is set to.
+
+#define TAPE_IPS            75          //  Read/write speed, inches/sec
+#define TAPE_START_US       5400        //  Start time, microseconds
+#define TAPE_STOP_US        5400        //  Stop time, microseconds
+#define TAPE_LONG_GAP_US    50000       //  3.75 inch gap (TM, Skip)
+#define TAPE_REWIND_IPS     500         //  High speed rewind
+#define TAPE_REWIND_US      1000000     //  Rewind start and stop
+
+#define TAPE_BPI_200        200
+#define TAPE_BPI_556        556
+#define TAPE_BPI_800        800
+
+#define TAPE_RECORD_BUFFER  4096                    //  Initial record buffer
+
+//  Tape statistics, kept for each drive since the emulator started.  Host
+//  I/O is the file I/O done on the CPU thread.  Busy wait is the machine
+//  time from when a program first found the drive busy until it got it.
+
+struct TTapeStats {
+    long RecordsRead;
+    long RecordsWritten;
+    __int64 FramesRead;                             //  (or spaced over)
+    __int64 FramesWritten;
+    long TapeMarksRead;
+    long TapeMarksWritten;
+    long Backspaces;
+    long Rewinds;
+    long HostCalls;                                 //  File I/O calls
+    __int64 HostMicroseconds;                       //  Time in file I/O
+    __int64 BusyWaitCycles;                         //  CPU waiting on busy
+};
+
+class TTapeFile;                                    //  See UITAPEFILE.h
+class TTapeIndex;                                   //  See UITAPEINDEX.h
+
+class TTapeUnit : public TObject {
+
+protected:
+
+    int unit;                                       //  Unit number.
+
+    String filename;		                        //  Path to tape file
+    TTapeFile *fd;                                  //  Buffered tape file
+    TTapeIndex *index;                              //  Record start index
+    char tape_buffer;                               //  Char read from file
+    unsigned char *record;                          //  Record being written
+    long record_length;
+    long record_capacity;
+    bool checkpointed;                              //  True if .wip written
+
+    int record_number;                              //  Record number (0=bot)
+    TTapeStats stats;                               //  Statistics
+
+    bool loaded;                                    //  State flags
+    bool fileprotect;
+    bool ready;
+    bool selected;
+    bool tapeindicate;
+    bool highdensity;
+    bool bot;
+
+    int density;                                    //  Bits per inch
+    __int64 stopped_time;                           //  When tape stops moving
+
+    bool irg_read;                                  //  True if tape_buffer full
+    bool write_irg;                                 //  Write IRG on next write
+    bool modified;
+
+    TBusyDevice *BusyEntry;
+
+private:
+
+	int ReadNextChar();                             //  Factored I/O call
+    void ResetFile();                               //  Close file, reset flags
+    void CloseFile();                               //  Delete fd, keep stats
+    void SaveIndex();                               //  Close file, save index
+    bool CommitRecord();                            //  Record out to file
+    bool Checkpoint(bool done);                     //  Update .wip file
+    void Recover();                                 //  Fix up after crash
+    void GoBusy(long start, long chars, long gap);  //  Timing model
+
+public:
+
+    //  Functions to make part of state visible to the outside
+
+    inline bool Selected() { return selected; }
+    inline bool IsReady() { return ready; }
+    inline bool IsFileProtected() { return fileprotect; }
+    inline bool TapeIndicate() { return tapeindicate; }
+    inline void ResetIndicate() { tapeindicate = false; }
+    inline bool HighDensity() { return highdensity; }
+    inline String GetFileName() { return filename; }
+    inline bool IsLoaded() { return loaded; }
+    inline bool IsBusy() { return BusyEntry -> TestBusy(); }
+    TBusyDevice *GetBusyDevice() { return BusyEntry; }
+    inline bool IsAtBot() { return bot; }
+    inline int GetRecordNumber() { return record_number; }
+    inline long GetRecordsRead() { return stats.RecordsRead; }
+    inline long GetRecordsWritten() { return stats.RecordsWritten; }
+    TTapeStats GetStats();                          //  Including open file
+    inline void AddBusyWait(__int64 c) { stats.BusyWaitCycles += c; }
+    inline void SetDensity(int bpi) { density = bpi; }
+    long CharacterTime();                           //  Cycles per character
+    long StartDelay();                              //  Cycles to first char
+    void EndRecord();                               //  Tape stops in IRG
+
+    //  Interface functions for the User Interface buttons
+
+    bool LoadRewind();
+    bool Reset();
+    bool Unload();
+    bool Start();
+    bool ChangeDensity();
+    bool Mount(String filename);
+
+    //  Get everything written so far safely onto the disk
+
+    bool Flush();                                   //  End of a run
+    void Close();                                   //  Shutting down
+
+    //  Interface functions for the Tape Adapter Unit (TAU) to use
+
+    TTapeUnit(int u);                               //  Constructor
+    void Init(int u);                               //  Initialization
+
+    bool Select(bool b);                            //  Select or De-select unit
+    bool Rewind();
+    bool RewindUnload();
+    bool Backspace();
+    bool Skip();                                    //  Skip and blank tape
+    void WriteIRG();                                //  Mark end of record
+    bool WriteTM();                                 //  Write Tape Mark (EOF)
+    int Space();                                    //  Space fwd 1 record
+
+    int Read();                                     //  Returns char or -value
+    bool Write(int c);                             //  Write file character
+};
+
+#endif